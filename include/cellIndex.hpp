@@ -0,0 +1,64 @@
+// include/cellIndex.hpp
+#ifndef CELL_INDEX_H
+#define CELL_INDEX_H
+
+#include <SFML/Graphics.hpp>    // sf::Vector2f
+#include <cstddef>              // std::size_t
+#include <cstdint>              // entity indices, bucket offsets
+#include <vector>               // bucket storage
+#include "botSystem.hpp"        // BotSystem
+
+/// Smallest bucket table of a CellIndex
+constexpr int CELL_INDEX_MIN_BUCKETS = 16;
+
+/// Which bots are in which maze cell: a spatial hash rebuilt every tick.
+///
+/// rebuild() is one counting sort of the bot indices by hashed cell:
+/// count per bucket, prefix sum, scatter.  The table has one bucket per
+/// bot (rounded up to a power of two), not one per cell, so a rebuild is
+/// O(bots) whatever the maze size and an 8192² stream costs no more than
+/// a 30² maze.  Cells that share a bucket are told apart by the cell
+/// stored next to each entry.  Within a cell, bots come out in index
+/// order; within() lists cell by cell, or in bucket order when it scans
+/// the whole index.
+///
+/// The index is a snapshot: moving, adding or removing bots leaves it
+/// stale until the next rebuild().  Bots outside the grid are left out.
+struct CellIndex {
+    int width  = 0;                     //!< Grid size of the last rebuild
+    int height = 0;
+    std::vector<std::uint32_t> start;   //!< Bucket b holds entries [start[b], start[b+1])
+    std::vector<std::uint32_t> items;   //!< Bot indices grouped by bucket
+    std::vector<std::int32_t>  cells;   //!< Flat cell of each entry of items
+
+    /// Re-sorts every bot of @p bots by its col/row on a
+    /// @p width × @p height grid
+    void rebuild(const BotSystem& bots, int width, int height);
+
+    /// True when some bot is in (col,row)
+    bool any(int col, int row) const;
+
+    /// Appends the bots in (col,row) to @p out
+    /// @return how many were appended
+    std::size_t inCell(int col, int row, std::vector<std::uint32_t>& out) const;
+
+    /// Appends the bots whose centre is within @p radius pixels of
+    /// @p centre to @p out, cell by cell over the covered square (or in
+    /// one pass over all bots when that square has more cells than there
+    /// are bots)
+    /// @return how many were appended
+    std::size_t within(const BotSystem& bots, sf::Vector2f centre, float radius,
+                       std::vector<std::uint32_t>& out) const;
+
+private:
+    unsigned                   shift = 32;  //!< 32 − log2(bucket count)
+    std::vector<std::uint32_t> bucketOf;    //!< Scratch: bucket of each bot
+    std::vector<std::uint32_t> fill;        //!< Scratch: scatter cursors
+
+    std::uint32_t bucket(int cell) const
+    {
+        return (static_cast<std::uint32_t>(cell) * 0x9E3779B1u) >> shift; // Fibonacci hash
+    }
+};
+
+#endif // CELL_INDEX_H
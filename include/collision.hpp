@@ -0,0 +1,35 @@
+// include/collision.hpp
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <SFML/Graphics.hpp>    // sf::Vector2f
+#include "quantumKernels.hpp"  // EvolveStencil (exit masks)
+
+/// Wall events one sweep may resolve; the rest of the step is dropped, so
+/// even an absurd step ends inside the maze instead of tunnelling
+constexpr int SWEEP_MAX_EVENTS = 64;
+
+/// What a circle does when it meets a wall
+enum class WallResponse {
+    Bounce,   // reflect the velocity component (bots)
+    Slide     // cancel it and keep moving along the wall (player)
+};
+
+/// Moves a circle of radius @p radius from @p position along
+/// @p velocity · @p dt, stepping cell by cell along the segment (DDA).
+///
+/// In each cell the centre may reach an open side's edge, which moves it
+/// into the neighbour, or stop @p radius short of a walled side, where it
+/// bounces or slides for the time that is left.  Any step length is
+/// handled exactly, up to SWEEP_MAX_EVENTS cell crossings and contacts.
+/// A centre already inside a wall's margin while moving towards the wall
+/// is put back on the margin.  Wall ends (the posts where walls meet) are
+/// not modelled: a circle passing an open side only tests the walls of the
+/// cell its centre is in.
+///
+/// Walls come from the cached exit masks of @p stencil (evolveStencil()).
+/// @return wall contacts during the sweep
+int sweepCircle(const EvolveStencil& stencil, sf::Vector2f& position, sf::Vector2f& velocity,
+                float dt, float radius, WallResponse response);
+
+#endif // COLLISION_H
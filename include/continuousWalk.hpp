@@ -0,0 +1,63 @@
+// include/continuousWalk.hpp
+#ifndef CONTINUOUS_WALK_H
+#define CONTINUOUS_WALK_H
+
+#include <vector>            // amplitudes, Chebyshev vectors
+#include "mazeHelper.hpp"    // Grid
+
+/// Default bound on the L2 error of one ContinuousWalk::evolve() call
+constexpr double CTQW_DEFAULT_TOLERANCE = 1e-8;
+
+/// Largest b·t (spectral half-width times time) propagated by a single
+/// Chebyshev series; longer times are split into equal slices.  Keeps the
+/// Bessel recurrence well inside double range at a cost of ~15% extra
+/// terms per slice.
+constexpr double CTQW_MAX_SLICE_PHASE = 256.0;
+
+/// Generator of the continuous-time walk
+enum class CtqwHamiltonian {
+    Laplacian,   // H = D − A: the quantum analogue of diffusion
+    Adjacency    // H = −A
+};
+
+/// Continuous-time quantum walk ψ(t) = exp(−iHt) ψ(0) on the maze graph.
+///
+/// H is applied matrix-free from the cached exit masks of evolveStencil():
+/// (Hv)_i = diag_i v_i − Σ_{open side s of i} v_{nbr_s(i)}.  Gershgorin puts
+/// its spectrum in [a − b, a + b], so with H' = (H − a)/b
+///
+///     exp(−iHt) = e^{−iat} [ J_0(bt) + 2 Σ_{k≥1} (−i)^k J_k(bt) T_k(H') ]
+///
+/// and ‖T_k(H')‖ ≤ 1, so dropping every term past the first k > bt with
+/// 2|J_k(bt)| under the tolerance bounds the error by the tolerance (the
+/// tail decays super-exponentially).  Any t costs ~bt matrix-vector
+/// products in one call, independent of a step size.  Amplitudes are kept
+/// in double so the error control is not swamped by rounding.
+struct ContinuousWalk {
+    int             width       = 0;
+    int             height      = 0;
+    CtqwHamiltonian hamiltonian = CtqwHamiltonian::Laplacian;
+    double          tolerance   = CTQW_DEFAULT_TOLERANCE;  //!< Per evolve() call
+    double          time        = 0.0;                     //!< Total time evolved
+
+    std::vector<double> re, im;   //!< ψ, one complex amplitude per cell
+
+    /// Puts the walker on (col,row) at time 0
+    void initializeAt(const Grid& grid, int col, int row);
+
+    /// Propagates ψ by @p t on @p grid's walls
+    /// @return number of matrix-vector products used
+    int evolve(const Grid& grid, double t);
+
+    /// Writes |ψ(c)|² for every cell into @p out
+    void probability(std::vector<float>& out) const;
+
+    /// |ψ(col,row)|²
+    double probabilityAt(int col, int row) const;
+
+private:
+    std::vector<double> t0re, t0im, t1re, t1im, t2re, t2im;   //!< Chebyshev recurrence
+    std::vector<double> bessel;                               //!< J_k(bt), k = 0 … K
+};
+
+#endif // CONTINUOUS_WALK_H
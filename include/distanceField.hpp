@@ -0,0 +1,59 @@
+// include/distanceField.hpp
+#ifndef DISTANCE_FIELD_H
+#define DISTANCE_FIELD_H
+
+#include <cstdint>           // std::uint32_t distances, std::int8_t sides
+#include <vector>            // per-cell storage
+#include "mazeHelper.hpp"    // Grid
+
+/// Cached maze distance (in steps through open walls) from every cell to
+/// a set of source cells, normally the finish line.
+///
+/// One multi-source BFS fills `dist` and the flow table `flow` in
+/// O(cells); after that every agent reads its distance with at() and its
+/// next move with stepToward() in O(1), so any number of bots share one
+/// search per maze and finish.  Distances are 32-bit because a perfect
+/// maze on an 8192x8192 grid can have corridors far longer than 65535
+/// steps.
+///
+/// The cache is keyed on the single source passed to update(): moving the
+/// finish cell recomputes it on the next update().  Changes to the walls
+/// themselves are invisible to the cache, so whoever re-carves the grid
+/// (resetGame, stream scrolling) must call invalidate().
+struct DistanceField {
+    /// Distance of cells that cannot reach any source
+    static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFFu;
+
+    std::vector<std::uint32_t> dist; //!< width*height distances, row major
+    std::vector<std::int8_t>   flow; //!< Side towards a source per cell, -1 at sources / unreachable
+    int width  = 0;                  //!< Grid size the field was built for
+    int height = 0;
+
+    /// Forgets the cached field; the next update() recomputes it
+    void invalidate() { valid = false; }
+
+    /// True when dist holds a field for the current maze
+    bool isValid() const { return valid; }
+
+    /// Recomputes the field towards (col,row) unless it is already cached
+    /// @return true when a BFS was run
+    bool update(const Grid& grid, int col, int row);
+
+    /// Multi-source BFS: every cell in @p sources (flat indices) is at 0
+    void compute(const Grid& grid, const std::vector<int>& sources);
+
+    /// Distance of (col,row) to the nearest source
+    std::uint32_t at(int col, int row) const { return dist[col + row * width]; }
+
+    /// Side (SIDE_RIGHT … SIDE_TOP) of an open neighbour that is one step
+    /// closer to a source, or -1 at a source / unreachable cell
+    int stepToward(int col, int row) const { return flow[col + row * width]; }
+
+private:
+    bool             valid     = false;
+    int              sourceCol = -1;    //!< Cache key of update()
+    int              sourceRow = -1;
+    std::vector<int> queue;             //!< BFS queue, reused across runs
+};
+
+#endif // DISTANCE_FIELD_H
@@ -0,0 +1,84 @@
+// include/fastForward.hpp
+#ifndef FAST_FORWARD_H
+#define FAST_FORWARD_H
+
+#include <cstdint>           // revisions
+#include <vector>            // fields and matrices
+#include "mazeHelper.hpp"    // Grid
+#include "quantumKernels.hpp" // EvolveStencil
+
+/// Largest grid (in cells) whose transition-matrix powers are cached
+constexpr int QUANTUM_POWER_MAX_CELLS = 256;
+
+/// Steps between two checks for convergence to the stationary limit
+constexpr int QUANTUM_LIMIT_CHECK_STEPS = 256;
+
+/// L1 distance to the limit under which the walk counts as mixed.
+/// The walk never moves a field away from its limit in L1, so jumping to
+/// the limit from there is exact to this tolerance for any further k.
+constexpr float QUANTUM_LIMIT_EPSILON = 1e-6f;
+
+/// Float stepping settles a little off the exact limit (1e-5 … 1e-4 in L1
+/// on 12x12 … 30x30 mazes) and stalls there.  Below this distance a check
+/// that no longer improves on the previous one also counts as mixed: more
+/// steps would not bring the field any closer to the limit.  So this, not
+/// QUANTUM_LIMIT_EPSILON, is the L1 tolerance fastForwardField() promises.
+constexpr float QUANTUM_LIMIT_FLOOR = 1e-3f;
+
+/// Long-run distribution of the walk on one maze.
+///
+/// A maze is a bipartite graph, so the walk is periodic: the mass of each
+/// connected component's two colour classes swaps sides every step and,
+/// within the class it sits on, tends to a distribution proportional to
+/// the cell degree.  The limit therefore depends on the field only through
+/// the mass per (component, colour) and on the parity of the step count.
+struct StationaryWalk {
+    std::uint64_t      revision = 0;  //!< Grid::revision it was built from
+    int                classes  = 0;  //!< 2 * components
+    std::vector<int>   classOf;       //!< 2*component + colour, -1 if sealed
+    std::vector<float> weight;        //!< degree / edges of the component
+
+    /// Rebuilds the class labels if @p grid changed since the last call
+    void update(const Grid& grid, const EvolveStencil& stencil);
+
+    /// Limit of @p field advanced by a further @p steps (only the parity
+    /// matters) written to @p out
+    void project(const float* field, float* out, long long steps) const;
+
+    /// L1 distance between @p field and its limit at the same parity
+    float distance(const float* field) const;
+
+private:
+    mutable std::vector<double> mass; //!< Scratch: mass per class
+    void classMass(const float* field) const;
+};
+
+/// Cached powers P, P^2, P^4, … of the dense transition matrix of a small
+/// maze, so k steps cost popcount(k) matrix-vector products once built.
+struct TransitionPowers {
+    std::uint64_t                   revision = 0;
+    int                             cells    = 0;
+    std::vector<std::vector<float>> powers;    //!< powers[j] = P^(2^j), row major
+
+    /// Drops the powers if @p grid changed since the last call
+    void update(const Grid& grid, const EvolveStencil& stencil);
+
+    /// Advances @p field by @p steps, squaring new powers on demand
+    void apply(std::vector<float>& field, std::vector<float>& spare, long long steps);
+};
+
+/// Advances @p field (width*height floats on @p grid) by @p steps walk
+/// steps, picking the cheapest strategy:
+///   • grids of at most QUANTUM_POWER_MAX_CELLS cells when k is large
+///     enough to pay for the squarings still missing from the cache:
+///     repeated squaring of the transition matrix, O(log k) mat-vecs;
+///   • otherwise temporally blocked stepping (evolveKernelSteps), checking
+///     every QUANTUM_LIMIT_CHECK_STEPS steps whether the field has reached
+///     the cached stationary limit and jumping straight to it if so
+///     (within QUANTUM_LIMIT_FLOOR in L1 of stepping all the way).
+/// @p spare is scratch of the same size; a @p pool parallelises the
+/// stepping over row bands.
+void fastForwardField(const Grid& grid, std::vector<float>& field,
+                      std::vector<float>& spare, long long steps, ThreadPool* pool = nullptr);
+
+#endif // FAST_FORWARD_H
@@ -0,0 +1,98 @@
+// include/fieldStorage.hpp
+#ifndef FIELD_STORAGE_H
+#define FIELD_STORAGE_H
+
+#include <cstddef>           // std::size_t
+#include <cstdint>           // packed cell types
+#include <string>            // precision names
+#include <vector>            // packed planes
+#include "quantumKernels.hpp" // EvolveStencil
+
+/// Storage format of a probability field
+enum class FieldPrecision {
+    Float32,   // 4 bytes/cell, the plain float field
+    Float16,   // 2 bytes/cell, IEEE half of p·FIELD_HALF_SCALE
+    BFloat16,  // 2 bytes/cell, top half of the float: float range, 8-bit mantissa
+    Fixed32    // 4 bytes/cell, p in units of 1/FIELD_FIXED_ONE; mass conserved exactly
+};
+
+/// Parses "float32" / "float16" / "bfloat16" / "fixed32"; false if unknown
+bool parseFieldPrecision(const std::string& name, FieldPrecision& out);
+
+/// Name of @p precision as accepted by parseFieldPrecision
+const char* fieldPrecisionName(FieldPrecision precision);
+
+/// Float16 stores p·2^15: a whole unit of mass is 32768 (half max 65504)
+/// and the 1/cells of a uniform 4096x4096 field stays a normal half
+/// instead of sinking into the subnormals.  A power of two, so scaling is
+/// exact.
+constexpr float FIELD_HALF_SCALE = 32768.0f;
+
+/// Fixed32 unit: one whole unit of mass is 2^31, so any single cell and
+/// the total both fit in 32 bits (resolution 4.7e-10)
+constexpr std::uint32_t FIELD_FIXED_ONE = 0x80000000u;
+
+/// A probability field in reduced-precision storage.
+///
+/// Half formats are widened to float for the arithmetic (fp32
+/// accumulation) and rounded to nearest-even once per step, so their mass
+/// drifts by rounding, ~2^-11 (Float16) or ~2^-8 (BFloat16) relative per
+/// step.  Fixed32 splits every cell's mass into integer shares (quotient
+/// plus one unit of the remainder to the first exits), so Σ cells is
+/// bit-for-bit constant across steps.
+struct PackedField {
+    FieldPrecision             precision = FieldPrecision::Float16;
+    int                        cells     = 0;
+    std::vector<std::uint16_t> half;    //!< Float16 / BFloat16 cells
+    std::vector<std::uint32_t> fixed;   //!< Fixed32 cells
+
+    /// Sizes the planes for @p n cells of @p p without converting anything
+    void allocate(int n, FieldPrecision p);
+
+    /// Converts @p n floats into @p p storage (vectorised for the half
+    /// formats and Fixed32 when the CPU allows)
+    void pack(const float* in, int n, FieldPrecision p);
+
+    /// Converts @p in[0, end − begin) into cells [begin, end), keeping the
+    /// precision and size
+    void packRange(const float* in, int begin, int end);
+
+    /// Converts back into @p out (cells floats)
+    void unpack(float* out) const;
+
+    /// Converts cells [begin, end) into @p out[0, end − begin)
+    void unpack(float* out, int begin, int end) const;
+
+    /// Value of one cell as a float
+    float at(int cell) const;
+
+    /// Stores @p value into one cell
+    void set(int cell, float value);
+
+    /// @p n cells of @p p, all holding @p value
+    void fill(int n, FieldPrecision p, float value);
+
+    /// Sizes this field like @p other without converting anything
+    void resizeLike(const PackedField& other);
+
+    /// Moves every cell @p n cells towards the front and zeroes the last
+    /// @p n (a scroll by n / width rows)
+    void shiftDown(int n);
+
+    /// Σ cells in double, decoded a chunk at a time
+    double sum() const;
+
+    /// Multiplies every cell by @p factor (one rounding per cell)
+    void scale(float factor);
+
+    /// Bytes of cell storage
+    std::size_t bytes() const { return half.size() * sizeof(std::uint16_t) + fixed.size() * sizeof(std::uint32_t); }
+};
+
+/// One quantum-walk step on packed storage: reads @p in, overwrites every
+/// cell of @p out (sized like @p in).  Same gather form and summation
+/// order as evolveKernel.  Half formats run AVX-512 / AVX2+F16C / scalar
+/// kernels, Fixed32 an AVX-512 / scalar integer kernel.
+void evolvePacked(const EvolveStencil& stencil, const PackedField& in, PackedField& out);
+
+#endif // FIELD_STORAGE_H
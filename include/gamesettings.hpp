@@ -1,13 +1,21 @@
 #ifndef GAMESETTINGS_H
 #define GAMESETTINGS_H
 #include <iostream>
-#include "../include/mazeHelper.hpp"            // grid constants, Node, drawMaze()
+#include "../include/mazeHelper.hpp"            // Grid, Node, drawMaze()
 #include "../include/particle.hpp"   // ClassicalParticle, QuantumParticle
+#include "../include/mazeGenerator.hpp" // MazeGenerator
+#include "../include/mazeStream.hpp"    // MazeStream
+#include "../include/distanceField.hpp" // DistanceField
+#include "../include/botSystem.hpp"     // BotSystem (bots)
 //to puting some event that may be necessary to the game
 
-void generateBots(std::vector<ClassicalParticle*>& bots, int numBots, Node* nodeList);
+// appends numBots bots to the system; one allocation per array at most
+void generateBots(BotSystem& bots, int numBots, const Grid& grid);
 
-void resetGame(Node* nodeList, std::vector<Wall>& wallVec, PlayerParticle& player,
-    std::vector<ClassicalParticle*>& bots, bool& mazeReady, int& cur_col, int& cur_row);
+// stream: when non-null the endless maze restarts instead of a full generate()
+// finishField: when non-null it is invalidated along with the old maze
+void resetGame(Grid& grid, MazeGenerator& generator, PlayerParticle& player,
+    BotSystem& bots, bool& mazeReady, int& cur_col, int& cur_row,
+    MazeStream* stream = nullptr, DistanceField* finishField = nullptr);
 
 #endif
\ No newline at end of file
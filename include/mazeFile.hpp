@@ -0,0 +1,105 @@
+// include/mazeFile.hpp
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+#include <cstddef>           // std::size_t
+#include <cstdint>           // fixed-width header fields
+#include <string>            // file paths
+#include "mazeHelper.hpp"    // Grid
+
+/// Current on-disk format version (bumped on any layout change)
+constexpr std::uint32_t MAZE_FILE_VERSION = 1;
+
+/// Byte offset of the first bitplane; keeps the planes 64-byte aligned
+constexpr std::uint64_t MAZE_FILE_PLANE_OFFSET = 128;
+
+/// Fixed header at the start of a `.qmaze` file.
+///
+/// Layout (little endian, native word order):
+///
+///     [0, 128)                  MazeFileHeader, zero padded
+///     [128, 128 + 8*words)      openRight plane (height * stride words)
+///     [.., .. + 8*words)        openDown  plane
+///
+/// The planes are the Grid bitplanes verbatim, row padding included, so a
+/// mapped file can be read with the same exitMask arithmetic as a Grid.
+/// The visited plane is not stored: a saved maze is always complete.
+struct MazeFileHeader {
+    char          magic[8];     // "QMAZE\0\0\0"
+    std::uint32_t version;      // MAZE_FILE_VERSION
+    std::uint32_t headerBytes;  // sizeof(MazeFileHeader)
+    std::uint32_t width;        // columns
+    std::uint32_t height;       // rows
+    std::uint32_t stride;       // 64-bit words per row
+    std::uint32_t algorithm;    // MazeAlgorithm that carved it
+    std::uint64_t seed;         // master seed of the generating run
+    std::int32_t  startCol;     // player / generator start cell
+    std::int32_t  startRow;
+    std::int32_t  finishCol;    // finish line cell
+    std::int32_t  finishRow;
+    std::uint64_t planeOffset;  // byte offset of openRight
+    std::uint64_t planeWords;   // words per plane (height * stride)
+};
+
+/// Metadata stored next to the walls
+struct MazeFileInfo {
+    std::uint64_t seed      = 0;
+    int           algorithm = 0;
+    int           startCol  = 0;
+    int           startRow  = 0;
+    int           finishCol = 0;
+    int           finishRow = 0;
+};
+
+/// Writes @p grid and @p info to @p path in the `.qmaze` format
+/// @return false (after printing to std::cerr) if the file cannot be written
+bool saveMazeFile(const std::string& path, const Grid& grid, const MazeFileInfo& info);
+
+/// Read-only, memory-mapped `.qmaze` file.
+///
+/// open() maps the file with MAP_SHARED / PROT_READ: nothing is read or
+/// parsed up front, pages fault in on first touch, and every process that
+/// maps the same file shares one copy in the page cache.  The bitplanes can
+/// be used in place through openRight()/openDown(), exactly as stored, or
+/// copied into a Grid with copyTo() (a plain memcpy per plane, no decoding,
+/// then the border and padding bits are cleared).
+struct MappedMaze {
+    MappedMaze() = default;
+    ~MappedMaze();
+    MappedMaze(const MappedMaze&)            = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+
+    /// Maps and validates @p path
+    /// @return false (after printing to std::cerr) on I/O or format errors
+    bool open(const std::string& path);
+
+    /// Unmaps the file (also done by the destructor)
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+    int  width()  const { return static_cast<int>(header->width); }
+    int  height() const { return static_cast<int>(header->height); }
+    int  stride() const { return static_cast<int>(header->stride); }
+
+    /// Seed, algorithm and start / finish cells
+    MazeFileInfo info() const;
+
+    /// Mapped openRight plane (height * stride words)
+    const std::uint64_t* openRight() const { return planes; }
+
+    /// Mapped openDown plane (height * stride words)
+    const std::uint64_t* openDown() const { return planes + header->planeWords; }
+
+    /// Copies the walls into @p grid, resizing it to the file's dimensions,
+    /// and marks every cell visited.  Exits the file opens through the
+    /// outer border or in padding bits are closed, with a warning.
+    void copyTo(Grid& grid) const;
+
+private:
+    void*                 base   = nullptr; //!< mmap address
+    std::size_t           length = 0;       //!< mapped bytes
+    const MazeFileHeader* header = nullptr; //!< == base once validated
+    const std::uint64_t*  planes = nullptr; //!< first word of openRight
+};
+
+#endif // MAZE_FILE_H
@@ -4,12 +4,25 @@
 
 #include <SFML/Graphics.hpp> // For graphics rendering
 #include <vector>            // For std::vector usage
+#include <cstdint>           // For std::uint64_t bitplane words
 #pragma once    
 
-// Maze grid dimensions
-constexpr int GRID_WIDTH  = 30;  // Number of columns
-constexpr int GRID_HEIGHT = 30;  // Number of rows
-constexpr int NODE_SIZE   = 15;  // Pixel size of each cell
+// Maze grid dimensions are chosen at runtime (see Grid below)
+constexpr int DEFAULT_GRID_WIDTH  = 30;   // Default number of columns
+constexpr int DEFAULT_GRID_HEIGHT = 30;   // Default number of rows
+constexpr int NODE_SIZE           = 15;   // Pixel size of each cell
+
+// Largest supported side of a grid.  Cell indices stay ints and edge ids
+// 32-bit up to here (2 × 16384² edges < 2^32).
+// Memory budget at MAX_GRID_DIM x MAX_GRID_DIM (268,435,456 cells):
+//   • Grid (3 bitplanes, 3 bit/cell)            ~  96 MiB
+//   • QuantumParticle (float + evolve scratch)  ~   2 GiB each
+//       Float16 / BFloat16 packed planes        ~   1 GiB each
+//   • QuantumEnsemble (field + scratch matrix)  ≤   1 GiB on any grid: it
+//       drops walkers to fit QUANTUM_ENSEMBLE_MAX_BYTES, none above ~8.4M
+//       cells, so it is empty here
+// Everything lives on the heap, nothing scales with the stack.
+constexpr int MAX_GRID_DIM = 16384;
 
 //add a finish line to the maze
 // extern int FINISH_COL=GRID_WIDTH-1; // Finish line column
@@ -26,7 +39,7 @@ enum {
     SIDE_TOP   = 3  // Top wall
 };
 
-/// Represents a single maze cell
+/// Decoded view of a single maze cell (built on demand by Grid::node)
 struct Node {
     bool walls[4] = { true, true, true, true }; // Walls [right, bottom, left, top]
     bool visited  = false; // Visitation flag for maze generation
@@ -35,8 +48,92 @@ struct Node {
 
 /// Represents a wall between two adjacent cells
 struct Wall {
-    Node* node1; // First adjacent cell
-    Node* node2; // Second adjacent cell
+    int cell1; // First adjacent cell (flat index)
+    int cell2; // Second adjacent cell (flat index)
+};
+
+/// Heap-backed maze grid whose size is chosen at runtime.
+///
+/// Topology is stored as three bitplanes instead of one Node per cell:
+///   • openRight — bit set when the wall between (c,r) and (c+1,r) is open
+///   • openDown  — bit set when the wall between (c,r) and (c,r+1) is open
+///   • visited   — generator bookkeeping
+/// Every shared wall lives in exactly one bit.  Each row is padded to whole
+/// 64-bit words (`stride` words per row) so word `w` of row `r` covers cells
+/// 64*w … 64*w+63 and exitMask() can answer for 64 cells at once.
+struct Grid {
+    int width  = DEFAULT_GRID_WIDTH;  // Number of columns
+    int height = DEFAULT_GRID_HEIGHT; // Number of rows
+    int stride = 1;                   // 64-bit words per row
+    std::vector<std::uint64_t> openRight; // height*stride words
+    std::vector<std::uint64_t> openDown;  // height*stride words
+    std::vector<std::uint64_t> visited;   // height*stride words
+    std::uint64_t revision = 0;           // unique id of the current walls
+
+    /// Allocates a grid with every wall standing
+    /// @param width Number of columns, clamped to [1, MAX_GRID_DIM]
+    /// @param height Number of rows, clamped to [1, MAX_GRID_DIM]
+    explicit Grid(int width = DEFAULT_GRID_WIDTH, int height = DEFAULT_GRID_HEIGHT);
+
+    /// Puts every wall back up and clears the visited plane
+    void reset();
+
+    /// Gives the walls a new revision so caches keyed on it rebuild.
+    /// reset() does this; code that edits the planes outside a generator
+    /// pass (stream scrolling, file loads) must call it when done.
+    void touch();
+
+    /// Number of cells in the grid
+    int cellCount() const { return width * height; }
+
+    /// Flat index of (col,row)
+    int index(int col, int row) const { return col + row * width; }
+
+    /// True when the wall on @p side of (col,row) is standing.
+    /// The outer border always counts as a wall.
+    bool hasWall(int col, int row, int side) const
+    {
+        switch (side)
+        {
+            case SIDE_RIGHT: return !testBit(openRight, col, row);
+            case SIDE_DOWN:  return !testBit(openDown,  col, row);
+            case SIDE_LEFT:  return col == 0 || !testBit(openRight, col - 1, row);
+            default:         return row == 0 || !testBit(openDown,  col, row - 1);
+        }
+    }
+
+    /// Knocks down the wall on @p side of (col,row), the neighbour is implied
+    void openWall(int col, int row, int side);
+
+    bool isVisited(int col, int row) const { return testBit(visited, col, row); }
+    void markVisited(int col, int row)
+    {
+        visited[row * stride + (col >> 6)] |= std::uint64_t{1} << (col & 63);
+    }
+
+    /// Open exits of the 64 cells in word @p word of @p row towards @p side.
+    /// Bit i refers to column 64*word + i; padding bits are always zero.
+    std::uint64_t exitMask(int row, int word, int side) const
+    {
+        const std::size_t w = static_cast<std::size_t>(row) * stride + word;
+        switch (side)
+        {
+            case SIDE_RIGHT: return openRight[w];
+            case SIDE_DOWN:  return openDown[w];
+            case SIDE_LEFT:  return (openRight[w] << 1) |
+                                    (word > 0 ? openRight[w - 1] >> 63 : 0);
+            default:         return row > 0 ? openDown[w - stride] : 0;
+        }
+    }
+
+    /// Decodes (col,row) into a Node view (walls + visited)
+    Node node(int col, int row) const;
+
+private:
+    bool testBit(const std::vector<std::uint64_t>& plane, int col, int row) const
+    {
+        return (plane[row * stride + (col >> 6)] >> (col & 63)) & 1u;
+    }
 };
 
 /// Draws the finish line at the specified cell
@@ -46,31 +143,32 @@ struct Wall {
 void drawFinish(sf::RenderWindow& window, int col, int row);
 /// Adds walls of a specific cell to the wall list
 /// @param wallVec Target vector to store walls
-/// @param nodeList Array of all grid cells
+/// @param grid Maze grid
 /// @param col Column of target cell
 /// @param row Row of target cell
-void addWalls(std::vector<Wall>& wallVec, Node nodeList[], int col, int row);
+void addWalls(std::vector<Wall>& wallVec, Grid& grid, int col, int row);
 
 /// Draws the entire maze grid and highlights current cell
 /// @param window SFML render window
-/// @param nodeList Array of all cells
+/// @param grid Maze grid
 /// @param curCol Current cell column (for highlighting)
 /// @param curRow Current cell row (for highlighting)
-void drawMaze(sf::RenderWindow& window, Node nodeList[], int curCol, int curRow);
+void drawMaze(sf::RenderWindow& window, const Grid& grid, int curCol, int curRow);
 
 /// Draws a single cell and its walls
 /// @param window SFML render window
-/// @param nodeList Array of cells
+/// @param grid Maze grid
 /// @param col Cell column
 /// @param row Cell row
 /// @param isCurrent If true, highlights cell in blue
-void drawNode(sf::RenderWindow& window, Node nodeList[], int col, int row, bool isCurrent = false);
+void drawNode(sf::RenderWindow& window, const Grid& grid, int col, int row, bool isCurrent = false);
 
 /// Validates grid coordinates
+/// @param grid Maze grid
 /// @param col Column to check
 /// @param row Row to check
 /// @return True if (col,row) is within grid bounds
-bool indexIsValid(int col, int row);
+bool indexIsValid(const Grid& grid, int col, int row);
 
 /// Calculates adjacent column based on direction
 /// @param cur_col Current column
@@ -85,15 +183,16 @@ int nextCol(int cur_col, int side);
 int nextRow(int cur_row, int side);
 
 /// Finds connecting wall between two adjacent cells
+/// @param grid Maze grid (for the row stride)
 /// @param idx1 First cell index
 /// @param idx2 Second cell index
 /// @return Connecting wall side (enum value) or -1 if not adjacent
-int connectingSide(int idx1, int idx2);
+int connectingSide(const Grid& grid, int idx1, int idx2);
 
 /// Removes walls between two adjacent cells
-/// @param nodeList Array of cells
-/// @param n1 First cell
-/// @param n2 Second cell
-void joinNodes(Node nodeList[], Node* n1, Node* n2);
+/// @param grid Maze grid
+/// @param idx1 First cell index
+/// @param idx2 Second cell index
+void joinNodes(Grid& grid, int idx1, int idx2);
 
 #endif // MAZE_HELPER_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+// include/mazeStream.hpp
+#ifndef MAZE_STREAM_H
+#define MAZE_STREAM_H
+
+#include <cstdint>           // std::uint64_t row words
+#include <vector>            // pending row storage
+#include "mazeHelper.hpp"    // Grid
+#include "mazeGenerator.hpp" // EllerRows
+
+/// Endless maze that scrolls upward one row at a time.
+///
+/// The live rows are the rows of an ordinary Grid (the "view"), so every
+/// particle and draw routine keeps working on plain row indices.  New rows
+/// come from Eller's algorithm, which only needs the set labels of the
+/// current row: memory is O(width * view rows) however long the session
+/// runs.  Scrolling shifts the view bitplanes up by one row (3 bits per
+/// cell) and appends a freshly carved row at the bottom.
+///
+/// The DOWN walls of the bottom row lead into a row that does not exist
+/// yet; they are held back in `pendingDown` until the next scroll so no
+/// exit ever points outside the view.
+struct MazeStream {
+
+    /// Fills every row of @p view with a fresh stream
+    /// @param view Grid holding the live rows (its size is kept)
+    void begin(Grid& view);
+
+    /// Drops the top row, shifts the others up and carves a new bottom row
+    /// @param view Grid passed to begin()
+    void scroll(Grid& view);
+
+    /// Absolute index (since begin) of view row 0
+    long long topRow() const { return emitted - rows; }
+
+private:
+    EllerRows                  eller;       //!< O(width) row state
+    std::vector<std::uint64_t> pendingDown; //!< DOWN walls of the bottom row
+    long long                  emitted = 0; //!< Rows produced since begin()
+    int                        rows    = 0; //!< Rows in the view
+
+    /// Carves the next Eller row into the bottom row of @p view
+    void emitRow(Grid& view, int row);
+};
+
+#endif // MAZE_STREAM_H
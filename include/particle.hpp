@@ -8,9 +8,8 @@
 //
 // Dependencies:
 //   * SFML 3 (Graphics module)
-//   * mazeHelper.h  → Node definition, grid constants (GRID_WIDTH/HEIGHT,
-//                     NODE_SIZE) and helper functions:
-//                     nextCol(), nextRow(), indexIsValid()
+//   * mazeHelper.h  → Node and Grid definitions, NODE_SIZE and helper
+//                     functions: nextCol(), nextRow(), indexIsValid()
 //
 // All comments use Doxygen style so they can be turned into HTML/PDF docs with
 // a single `doxygen` run.
@@ -18,7 +17,13 @@
 
 #include <SFML/Graphics.hpp>
 #include "../include/mazeHelper.hpp"   // grid constants and helpers
-#include <algorithm>                  // std::copy (used by QuantumParticle)
+#include "../include/rng.hpp"          // Rng (QuantumParticle measurement)
+#include "../include/quantumKernels.hpp" // ActiveSet (sparse evolve)
+#include "../include/quantumWalk.hpp"  // QuantumWalk (coherent mode)
+#include "../include/sampler.hpp"      // FieldSampler (measurement)
+#include "../include/threadPool.hpp"   // ThreadPool (parallel evolve)
+#include "../include/fieldStorage.hpp" // PackedField (reduced precision)
+#include <vector>                     // QuantumParticle probability field
 
 //palyer particle it just a copy of classical particle but with a different color and name
 
@@ -32,9 +37,11 @@ struct PlayerParticle{
     // Radius used for drawing and collision (20% of cell size)
     inline float radius() const { return NODE_SIZE * 0.2f; }
 
-    void setPosition(int newCol, int newRow, Node nodeList[]);
-    void update(float dt, Node nodeList[]);
+    void setPosition(int newCol, int newRow, const Grid& grid);
+    void update(float dt, const Grid& grid);
     void draw(sf::RenderWindow& window) const;
+    /// Follows a MazeStream scroll: moves up @p rows, clamped to the top row
+    void scroll(int rows);
 };
 
 
@@ -52,6 +59,9 @@ struct PlayerParticle{
  *   - **velocity** ← **velocity** + **acceleration** · dt
  *   - **position** ← **position** + **velocity** · dt
  *
+ * The position step is swept through the maze (sweepCircle): the disc
+ * bounces off every wall it meets on the way, however long the step.
+ *
  * Rendering: a solid green disc with radius 0.3 × NODE_SIZE centred at
  * `position`.
  */
@@ -65,9 +75,11 @@ struct ClassicalParticle{
     // Radius used for drawing and collision (20% of cell size)
     inline float radius() const { return NODE_SIZE * 0.2f; }
 
-    void setPosition(int newCol, int newRow, Node nodeList[]);
-    void update(float dt, Node nodeList[]);
+    void setPosition(int newCol, int newRow, const Grid& grid);
+    void update(float dt, const Grid& grid);
     void draw(sf::RenderWindow& window) const;
+    /// Follows a MazeStream scroll: moves up @p rows, clamped to the top row
+    void scroll(int rows);
 };
 
 
@@ -78,45 +90,190 @@ struct ClassicalParticle{
  * @class QuantumParticle
  * @brief Discrete quantum‑walk entity represented by a probability field.
  *
- * Internally stores |ψ|² for every cell in a flat array of size
- * `GRID_WIDTH * GRID_HEIGHT`.
+ * Internally stores |ψ|² for every cell in a heap array of size
+ * `grid.width * grid.height`, sized by initialize(): `probability` at
+ * Float32, `packed` alone in reduced precision (see setPrecision()).
  */
+/// Support size, as a fraction of the grid, above which a sparse
+/// QuantumParticle switches to the dense kernel.  A sparse step costs
+/// ~50 ns per active cell (random access), a dense AVX-512 step ~0.6 ns
+/// per grid cell, so they break even near 1% of the grid.
+constexpr float QUANTUM_SPARSE_LIMIT = 0.01f;
+
 struct QuantumParticle{
 
-    float       probability[GRID_WIDTH * GRID_HEIGHT] = {0.f}; //!< Probability map.
+    std::vector<float> probability;                           //!< Probability map (empty while packed).
+    std::vector<float> scratch;                               //!< evolve() target, reused every step (empty while packed).
     sf::Color   color      = sf::Color::Blue;                 //!< Rendering colour.
     bool        collapsed  = false;                           //!< True after collapse().
     int         col = 0, row = 0;                             //!< Cell coordinates once collapsed.
+    Rng         rng = makeRng(RNG_STREAM_QUANTUM);            //!< Measurement stream.
+    bool        sparse = false;                               //!< Evolving only the support.
+    ActiveSet   active;                                       //!< Support while sparse.
+    ActiveSet   nextActive;                                   //!< Support being built by evolve().
+    bool        coherent = false;                             //!< Evolving complex amplitudes (walk).
+    QuantumWalk walk;                                         //!< Amplitudes while coherent.
+    FieldSampler sampler;                                     //!< Prefix sums / alias table of the field.
+    std::uint64_t measurements = 0;                           //!< Counter of measure() draws so far.
+    ThreadPool* pool = nullptr;                               //!< Workers for dense steps (nullptr: this thread).
+    long long   pendingSteps = 0;                             //!< Steps queued by advance(), not yet applied.
+    FieldPrecision precision = FieldPrecision::Float32;       //!< Storage the classical walk steps in.
+    PackedField packed;                                       //!< The field while precision is not Float32.
+    PackedField packedScratch;                                //!< evolve() target in reduced precision.
+
+    /** @brief True while the classical field lives in `packed` only. */
+    bool isPacked() const { return precision != FieldPrecision::Float32 && !coherent; }
+
+    /** @brief Cells of the stored field, whichever storage holds it. */
+    int fieldCells() const { return isPacked() ? packed.cells : static_cast<int>(probability.size()); }
+
+    /** @brief Size the field to @p grid and initialise a uniform distribution. */
+    void initialize(const Grid& grid);
+
+    /**
+     * @brief Size the field to @p grid and put all mass on (col,row).
+     *
+     * Starts in sparse mode: evolve() touches only the support and its
+     * neighbours until the support exceeds QUANTUM_SPARSE_LIMIT of the
+     * grid, then switches to the dense kernel for good.
+     */
+    void initializeAt(const Grid& grid, int col, int row);
 
-    /** @brief Initialise with a uniform distribution. */
-    void initialize(Node* nodeList);
+    /**
+     * @brief Switch to the coined quantum walk, started on (col,row).
+     *
+     * From then on evolve() steps the complex amplitudes of @p walk with
+     * @p coin and keeps `probability` = |ψ|², so collapse() and draw()
+     * work unchanged.  initialize() / initializeAt() switch back to the
+     * classical walk.
+     */
+    void initializeCoherent(const Grid& grid, int col, int row, QuantumCoin coin);
 
     /**
      * @brief Perform one evolution step of the quantum walk.
      *
      * Probability at each open cell is evenly distributed to its neighbours
-     * according to the maze topology stored in @p nodeList.
+     * according to the maze topology stored in @p grid.  Runs the gather
+     * kernel of quantumKernels.hpp over a stencil cached per maze revision,
+     * or the sparse kernel over the active set while in sparse mode.  With
+     * a `pool` and at least QUANTUM_PARALLEL_MIN_CELLS cells the dense
+     * step is split into row bands across the pool's threads.
      *
-     * @param nodeList  Flat array of Node objects describing the maze layout.
+     * @param grid  Maze grid describing the layout.
      */
-    void evolve(Node nodeList[]);
+    void evolve(const Grid& grid);
+
+    /**
+     * @brief Queue @p steps walk steps without running them.
+     *
+     * The steps are applied in one fastForward() call the next time
+     * something reads the state: settle(), field(), collapse(), measure(),
+     * or draw() of the uncollapsed field.  A walker nobody looks at (off
+     * screen, paused, behind a collapsed dot) costs nothing per frame, and
+     * k queued steps run through the multi-step strategies instead of k
+     * separate sweeps.
+     */
+    void advance(long long steps = 1) { pendingSteps += steps; }
+
+    /** @brief Apply the steps queued by advance() on @p grid's walls. */
+    void settle(const Grid& grid);
+
+    /**
+     * @brief Step the classical walk in reduced-precision storage.
+     *
+     * Float16 / BFloat16 halve the bytes each dense step streams (fp32
+     * accumulation, one rounding per step); Fixed32 keeps the footprint
+     * but conserves total mass exactly.  The packed planes are then the
+     * only storage: `probability` and `scratch` are freed, so a field
+     * costs 2 + 2 bytes per cell (field + step target) in the half
+     * formats instead of 4 + 4.  collapse() and measure() sample from
+     * block prefix sums over the packed cells and draw() decodes the
+     * cells it looks at; nothing unpacks the whole field per tick.
+     * Packed fields always use the dense kernel and step one at a time
+     * in fastForward().  The coherent walk keeps its own float amplitudes
+     * and ignores this.
+     *
+     * @param grid       Maze grid the field lives on.
+     * @param precision  New storage format; Float32 returns to plain floats.
+     */
+    void setPrecision(const Grid& grid, FieldPrecision precision);
+
+    /**
+     * @brief The probability field, with every queued step applied.
+     *
+     * A packed field is decoded into `probability` for the call: a full
+     * float copy that the next evolve() or scroll() frees again.  Meant
+     * for inspection, not for per-frame use.
+     */
+    const std::vector<float>& field(const Grid& grid);
+
+    /**
+     * @brief Advance the walk @p steps steps at once.
+     *
+     * Same result as @p steps calls to evolve() up to float rounding,
+     * except once it jumps to the stationary limit: then the L1 error is
+     * below QUANTUM_LIMIT_FLOOR, the distance at which float stepping may
+     * stall (QUANTUM_LIMIT_EPSILON when it got that close).  Picks a
+     * cheaper strategy: sparse steps while localized, then
+     * fastForwardField() (matrix powers on small mazes, temporal blocking
+     * and a cached stationary limit otherwise).
+     *
+     * @param grid   Maze grid describing the layout.
+     * @param steps  Number of walk steps.
+     */
+    void fastForward(const Grid& grid, long long steps);
 
     /**
      * @brief Collapse the wavefunction, sampling a single cell position.
      *
-     * Uses a random float in [0,1) to pick the first cell where the cumulative
-     * probability exceeds that value.
+     * Uses a random 53-bit double in [0,1) to pick the first cell where the
+     * cumulative probability exceeds that value: a binary search over the
+     * double prefix sums of FieldSampler, so it always lands on a cell with
+     * mass and can reach every cell of a grid above 2^24 cells.
+     *
+     * @param grid  Maze grid (for index → (col,row) conversion).
+     */
+    void collapse(const Grid& grid);
+
+    /**
+     * @brief Draw @p count independent measurements of the current field.
+     *
+     * Builds the field's alias table once and takes every draw in O(1)
+     * from the counter-based stream of this particle, so a run of millions
+     * of Monte Carlo samples is reproducible and leaves the field (and
+     * `col`/`row`) untouched.  A packed field gets block prefix sums
+     * instead, so sampling adds no per-cell table to its footprint.  Cells are written as grid indices; the
+     * vector is empty if the field holds no mass.
+     *
+     * @param grid   Maze grid (for the queued steps).
+     * @param count  Number of measurements.
+     * @param cells  Receives the measured cell indices.
      */
-    void collapse();
+    void measure(const Grid& grid, int count, std::vector<int>& cells);
 
     /**
      * @brief Render the probability blobs or the collapsed particle.
+     *
+     * Settles queued steps only when the field itself is drawn; a
+     * collapsed particle is drawn from `col`/`row` alone.
+     *
      * @param window  SFML render target.
+     * @param grid    Maze grid the field lives on.
      */
-    void draw(sf::RenderWindow& window) const;
-    static void addQuantumParticle(std::vector<QuantumParticle*>& out,
-                                    int numParticles,
-                                    Node*);
+    void draw(sf::RenderWindow& window, const Grid& grid);
+
+    /**
+     * @brief Follow a MazeStream scroll by moving the field up @p rows rows.
+     *
+     * Mass in the rows that leave the view is dropped and the rest is
+     * renormalised; an empty field restarts uniform.  Steps still queued
+     * by advance() run on the scrolled grid, so settle() against the old
+     * grid first when the order matters.
+     *
+     * @param rows  Number of rows the view scrolled.
+     * @param grid  The (already scrolled) view grid.
+     */
+    void scroll(int rows, const Grid& grid);
 
     // void addQuantumParticle(std::vector<QuantumParticle*>& particles, int numParticles, Node* nodeList) {}
 
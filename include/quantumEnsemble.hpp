@@ -0,0 +1,77 @@
+// include/quantumEnsemble.hpp
+#ifndef QUANTUM_ENSEMBLE_H
+#define QUANTUM_ENSEMBLE_H
+
+#include <SFML/Graphics.hpp>    // sf::Color, sf::RenderWindow
+#include <cstddef>              // std::size_t
+#include <vector>               // field and per-walker storage
+#include "mazeHelper.hpp"       // Grid
+#include "rng.hpp"              // Rng (per-walker measurement streams)
+
+/// Most bytes an ensemble's two matrices (field + evolve scratch) may take.
+/// initialize() drops walkers to fit: 100 walkers (112 lanes, 896 B/cell)
+/// fit up to ~1.2M cells, and above ~8.4M cells (16 lanes) none do.
+constexpr std::size_t QUANTUM_ENSEMBLE_MAX_BYTES = std::size_t{1} << 30;
+
+/// Many independent quantum walkers sharing one maze.
+///
+/// The N probability fields are stored interleaved, cell-major with the
+/// walkers of a cell contiguous: `probability[cell * lanes + walker]`.
+/// One evolve() is then a single sparse-stencil × dense-matrix product
+/// (evolveEnsembleKernel): the maze topology is read once per step for all
+/// walkers instead of once per walker, and the inner loop is a contiguous
+/// SIMD sweep over the walkers of a cell.  `lanes` is N rounded up to
+/// QUANTUM_ENSEMBLE_ALIGN; padding lanes carry no mass.
+///
+/// Each walker evolves exactly like a QuantumParticle started from the
+/// same field.  Compared with N heap-allocated QuantumParticles this drops
+/// the per-object allocations and makes 10k walkers per maze practical.
+struct QuantumEnsemble {
+    int requested = 0;              //!< Walkers asked for by initialize()
+    int count = 0;                  //!< Walkers, requested capped to QUANTUM_ENSEMBLE_MAX_BYTES
+    int lanes = 0;                  //!< Floats per cell (count, padded)
+    int cells = 0;                  //!< Grid cells the fields cover
+
+    std::vector<float>     probability; //!< cells * lanes, cell-major
+    std::vector<float>     scratch;     //!< evolve() target, reused every step
+    std::vector<int>       col, row;    //!< Cell of each walker's last collapse
+    std::vector<sf::Color> color;       //!< Rendering colour of each walker
+    std::vector<Rng>       rng;         //!< Measurement stream of each walker
+    long long              pendingSteps = 0; //!< Steps queued by advance(), not yet applied
+
+    /// Sizes the ensemble for @p grid with @p numWalkers uniform walkers,
+    /// fewer (down to none) if they would exceed QUANTUM_ENSEMBLE_MAX_BYTES
+    void initialize(const Grid& grid, int numWalkers);
+
+    /// One quantum-walk step of every walker (after any queued ones)
+    void evolve(const Grid& grid);
+
+    /// Queues @p steps steps of every walker without running them, like
+    /// QuantumParticle::advance(): they run back to back, with no
+    /// measurement in between, at the next settle() or collapseAll()
+    void advance(long long steps = 1) { pendingSteps += steps; }
+
+    /// Applies the steps queued by advance() on @p grid's walls
+    void settle(const Grid& grid);
+
+    /// Measures every walker: samples one cell per walker from its field
+    /// into col/row, like FieldSampler (double CDF, 53-bit draw), in two
+    /// passes over the matrix (queued steps first)
+    void collapseAll(const Grid& grid);
+
+    /// Follows a MazeStream scroll: shifts every field up @p rows rows and
+    /// renormalises each walker (an emptied walker restarts uniform).
+    /// Queued steps would run on the scrolled grid: settle() first.
+    void scroll(int rows, const Grid& grid);
+
+    /// Draws each walker at its last measured cell
+    void draw(sf::RenderWindow& window) const;
+
+    /// Probability of @p walker at @p cell
+    float at(int walker, int cell) const
+    {
+        return probability[static_cast<std::size_t>(cell) * lanes + walker];
+    }
+};
+
+#endif // QUANTUM_ENSEMBLE_H
@@ -0,0 +1,71 @@
+// include/quantumWalk.hpp
+#ifndef QUANTUM_WALK_H
+#define QUANTUM_WALK_H
+
+#include <cstdint>           // revisions
+#include <string>            // coin names
+#include <vector>            // amplitude planes
+#include "mazeHelper.hpp"    // Grid, SIDE_* directions
+
+/// Coin operator of the coined quantum walk, restricted at every cell to
+/// the directions whose wall is open (closed directions get the identity)
+enum class QuantumCoin {
+    Grover,   // 2/k·J − I on the k open exits: real, symmetric spreading
+    Fourier   // k×k DFT on the open exits; k = 2 is the Hadamard coin
+};
+
+/// Parses "grover" / "fourier" (also "hadamard"); false if unknown
+bool parseQuantumCoin(const std::string& name, QuantumCoin& out);
+
+/// Coined discrete-time quantum walk with complex amplitudes.
+///
+/// The state is one complex amplitude per (cell, direction), direction in
+/// SIDE_RIGHT … SIDE_TOP, stored structure-of-arrays: eight planes of
+/// `cells` floats, re/im for each direction, so a step is a plain
+/// lane-parallel sweep.  A step is coin then shift:
+///
+///   • coin:  ψ(c,·) ← C_{mask(c)} ψ(c,·), C looked up in a 16-entry table
+///            by the cell's open-exit mask;
+///   • shift: flip-flop with reflecting walls,
+///            ψ'(c,d) = ψ(c+d, opposite(d))  if the wall d of c is open,
+///            ψ'(c,d) = ψ(c, d)              otherwise,
+///
+/// both unitary, so the total probability Σ|ψ|² stays 1 and amplitudes
+/// interfere.  `state` holds the amplitudes right after the coin (the
+/// amplitude of leaving c through side d), which lets step() run a shift
+/// and the next coin as one sweep; per-cell probabilities are the same
+/// either way since the coin is unitary on each cell.  Kernels are
+/// AVX-512 / AVX2 with a scalar fallback, picked at runtime like the
+/// classical evolve kernels.
+struct QuantumWalk {
+    int         width  = 0;
+    int         height = 0;
+    QuantumCoin coin   = QuantumCoin::Grover;
+
+    std::vector<float> state;   //!< 8 planes × cells: re/im of RIGHT, DOWN, LEFT, TOP (post-coin)
+    std::vector<float> spare;   //!< step() target, reused every step
+
+    /// Puts the walker on (col,row) with equal amplitude on its open exits
+    void initializeAt(const Grid& grid, int col, int row);
+
+    /// One coin + shift step on @p grid's walls
+    void step(const Grid& grid);
+
+    /// Writes |ψ(c)|² = Σ_d |ψ(c,d)|² for every cell into @p out
+    void probability(std::vector<float>& out) const;
+
+    /// Follows a MazeStream scroll: moves the amplitudes up @p rows rows and
+    /// renormalises; an emptied walk restarts at the centre of the view
+    void scroll(int rows, const Grid& grid);
+
+    /// Name of the kernel set in use ("avx512", "avx2", "scalar")
+    static const char* kernelName();
+
+    float*       re(int dir)       { return &state[static_cast<std::size_t>(2 * dir) * cells()]; }
+    float*       im(int dir)       { return &state[static_cast<std::size_t>(2 * dir + 1) * cells()]; }
+    const float* re(int dir) const { return &state[static_cast<std::size_t>(2 * dir) * cells()]; }
+    const float* im(int dir) const { return &state[static_cast<std::size_t>(2 * dir + 1) * cells()]; }
+    int          cells()     const { return width * height; }
+};
+
+#endif // QUANTUM_WALK_H
@@ -0,0 +1,121 @@
+// include/rng.hpp
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>           // fixed-width state
+
+/// Subsystem ids used to derive independent streams from the master seed
+enum RngStream : std::uint64_t {
+    RNG_STREAM_MAZE    = 1, // maze generators
+    RNG_STREAM_BOTS    = 2, // ClassicalParticle spawning
+    RNG_STREAM_QUANTUM = 3, // QuantumParticle measurement
+    RNG_STREAM_THREAD  = 4  // threadRng(): main loop, resets, finish line
+};
+
+/// SplitMix64 finaliser: a strong 64-bit bit mixer
+inline std::uint64_t mix64(std::uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/// Counter-based random number: a pure function of (seed, stream, counter).
+/// Any thread can draw sample `counter` of `stream` without shared state,
+/// so parallel code is reproducible regardless of scheduling.
+inline std::uint64_t counterRandom(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter)
+{
+    return mix64(mix64(seed ^ mix64(stream)) + counter);
+}
+
+/// Uniform float in [0,1) from counterRandom
+inline float counterUniform(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter)
+{
+    return static_cast<float>(counterRandom(seed, stream, counter) >> 40) * (1.0f / 16777216.0f);
+}
+
+/// PCG32 (XSH-RR 64/32) generator.
+///
+/// 16 bytes of state, a few cycles per draw, and 2^63 selectable streams.
+/// Satisfies UniformRandomBitGenerator, so it works with std::shuffle and
+/// the <random> distributions.
+struct Rng {
+    using result_type = std::uint32_t;
+
+    std::uint64_t state = 0x853C49E6748FEA9Bull;
+    std::uint64_t inc   = 0xDA3E39CB94B95BDBull;
+
+    Rng() = default;
+    Rng(std::uint64_t seedValue, std::uint64_t stream = 0) { seed(seedValue, stream); }
+
+    /// Restarts the generator on @p stream of @p seedValue
+    void seed(std::uint64_t seedValue, std::uint64_t stream = 0)
+    {
+        state = 0;
+        inc   = (stream << 1) | 1u;
+        (*this)();
+        state += seedValue;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    /// Next 32 random bits
+    result_type operator()()
+    {
+        const std::uint64_t old = state;
+        state = old * 6364136223846793005ull + inc;
+        const std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        const std::uint32_t rot        = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    /// Unbiased integer in [0, n) (Lemire's multiply-shift with rejection)
+    std::uint32_t below(std::uint32_t n)
+    {
+        std::uint64_t m = static_cast<std::uint64_t>((*this)()) * n;
+        std::uint32_t low = static_cast<std::uint32_t>(m);
+        if (low < n)
+        {
+            const std::uint32_t threshold = (0u - n) % n;
+            while (low < threshold)
+            {
+                m   = static_cast<std::uint64_t>((*this)()) * n;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+    /// Uniform float in [0,1)
+    float uniform() { return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f); }
+
+    /// Uniform double in [0,1) with 53 random bits (two outputs), for
+    /// draws over more than 2^24 outcomes, where uniform() leaves gaps
+    double uniformDouble()
+    {
+        const std::uint64_t hi = (*this)();
+        const std::uint64_t bits = (hi << 32) | (*this)();
+        return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+/// Sets the run's master seed (from --seed) and reseeds the calling
+/// thread's threadRng().  Call once at startup, before creating entities.
+void setMasterSeed(std::uint64_t seed);
+
+/// Master seed of the run
+std::uint64_t masterSeed();
+
+/// Independent generator for entity @p index of @p subsystem, derived
+/// from the master seed.  Same seed and ids give the same sequence.
+Rng makeRng(std::uint64_t subsystem, std::uint64_t index = 0);
+
+/// Generator owned by the calling thread.  Threads are numbered in the
+/// order they first call this; code that must be reproducible across
+/// thread counts should use makeRng or counterRandom with a work-item id.
+Rng& threadRng();
+
+#endif // RNG_H
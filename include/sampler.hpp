@@ -0,0 +1,82 @@
+// include/sampler.hpp
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <cstdint>           // counter-based draws
+#include <functional>        // FieldReader
+#include <vector>            // prefix sums, alias table
+
+/// Decodes cells [begin, end) of a field into out[0, end − begin)
+using FieldReader = std::function<void(int begin, int end, float* out)>;
+
+/// Cells per block of FieldSampler::buildBlocks()
+constexpr int SAMPLER_BLOCK_CELLS = 4096;
+
+/// Draws cells from a probability field (any non-negative weights; they
+/// need not sum to 1).
+///
+/// build() makes an O(n) prefix sum in double, after which a draw is an
+/// O(log n) binary search: fine when each field is measured a few times,
+/// as in the per-frame collapse.  buildAlias() adds a Vose alias table
+/// (O(n) more) for O(1) draws when one field is sampled many times.  A
+/// draw never lands on a zero-probability cell, and u close to 1 cannot
+/// run off the end of the field the way a float running sum can.
+///
+/// buildBlocks() serves fields that are not stored as floats (PackedField):
+/// it keeps one running sum per SAMPLER_BLOCK_CELLS cells, O(n/4096)
+/// memory, and a draw re-reads only the block it lands in.  Its draws are
+/// the cells build() + sample() would give on the decoded field.
+struct FieldSampler {
+    std::vector<double> prefix;        //!< Inclusive running sum of the field
+    std::vector<double> blockPrefix;   //!< buildBlocks(): running sum at the end of each block
+    int                 cells = 0;     //!< buildBlocks(): cells of the field
+    std::vector<float>  aliasProb;     //!< Vose: chance of keeping slot i
+    std::vector<int>    alias;         //!< Vose: cell taken otherwise
+    double              total = 0.0;   //!< Field mass
+    int                 last  = -1;    //!< Last cell with mass, -1 if none
+
+    /// Builds the prefix sums of @p field (@p n cells)
+    /// @return false if the field holds no mass
+    bool build(const float* field, int n);
+
+    /// build() plus the alias table
+    bool buildAlias(const float* field, int n);
+
+    /// Builds per-block prefix sums of an @p n cell field read through
+    /// @p read; frees the per-cell tables
+    /// @return false if the field holds no mass
+    bool buildBlocks(int n, const FieldReader& read);
+
+    bool empty() const { return last < 0; }
+
+    /// Cell whose cumulative mass first exceeds u·total, u in [0,1);
+    /// binary search over the prefix sums.  -1 if empty.
+    int sample(double u) const;
+
+    /// sample() after buildBlocks(); @p read must see the same field
+    int sample(double u, const FieldReader& read) const;
+
+    /// O(1) draw from 64 random bits; needs buildAlias().  -1 if empty.
+    int sampleAlias(std::uint64_t bits) const;
+
+    /// Draws @p count cells into @p out using the counter-based stream
+    /// (@p seed, @p stream), counters first … first+count-1: the result
+    /// depends only on those, not on call order or threads.  Uses the
+    /// alias table if built, the prefix sums otherwise.
+    void sampleBatch(std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                     int count, int* out) const;
+
+    /// sampleBatch() after buildBlocks(): the draws are grouped by block,
+    /// so each block is decoded at most once per batch
+    void sampleBatch(std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                     int count, int* out, const FieldReader& read) const;
+
+private:
+    /// Running sums of block @p b, up to the last cell with mass
+    void blockSums(int b, const FieldReader& read, std::vector<float>& buf,
+                   std::vector<double>& sums) const;
+    /// Cell of block @p b whose running sum (@p sums) first exceeds @p target
+    int pickInBlock(int b, const std::vector<double>& sums, double target) const;
+};
+
+#endif // SAMPLER_H
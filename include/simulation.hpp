@@ -0,0 +1,118 @@
+// include/simulation.hpp
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SFML/Graphics.hpp>    // sf::Vector2f
+#include <cstdint>              // tick counter
+#include <vector>               // interpolation snapshot
+#include "mazeHelper.hpp"       // Grid
+#include "particle.hpp"         // PlayerParticle, QuantumParticle
+#include "botSystem.hpp"        // BotSystem
+#include "cellIndex.hpp"        // CellIndex
+#include "quantumEnsemble.hpp"  // QuantumEnsemble
+#include "distanceField.hpp"    // DistanceField
+#include "mazeStream.hpp"       // MazeStream
+
+/// Default simulation rate; one tick is also one quantum-walk step
+constexpr double SIM_DEFAULT_TICK_RATE = 60.0;
+
+/// Ticks advance() runs at most per frame; older backlog is dropped so a
+/// hitch slows the game down instead of freezing it in catch-up
+constexpr int SIM_MAX_CATCH_UP = 8;
+
+/// --stream: the view scrolls up one row this often (simulated seconds)
+constexpr float STREAM_SCROLL_SECONDS = 1.0f;
+
+/// Player speed at full stick, px/s
+constexpr float PLAYER_SPEED = 100.0f;
+
+/// --navigate: bot cruising speed along the flow field, px/s
+constexpr float BOT_NAV_SPEED = 80.0f;
+
+/// step() / advance() results, or-ed together
+enum SimulationEvent : unsigned {
+    SIM_PLAYER_FINISHED   = 1u,  // the player reached the finish cell
+    SIM_OPPONENT_FINISHED = 2u   // a bot or the quantum particle got there first
+};
+
+/// What the world gets from outside for one tick
+struct SimulationInput {
+    sf::Vector2f move{0.f, 0.f};   //!< Player direction, length ≤ 1
+    bool         autoCollapse = true; //!< Step the quantum walkers (measured by measure())
+};
+
+/// Fixed-timestep driver of the game world.
+///
+/// step() advances everything by exactly 1 / tickRate seconds, so a run is
+/// a pure function of the seed and the input of each tick: the same ticks
+/// give the same world with or without a window, at any frame rate.
+/// advance() feeds it wall-clock frame time through an accumulator,
+/// running at most maxCatchUp ticks per frame, and keeps the positions
+/// from before the last tick so the renderer can interpolate by alpha().
+/// The quantum walkers are measured after every tick, by advance() and
+/// by --headless alike, so their draws and finish events never depend on
+/// the frame schedule.  A caller stepping by hand pairs each step() with
+/// a measure().
+/// With `navigate` set the bots race the player: every tick they steer by
+/// the flow table of finishField, which is searched once per maze and
+/// finish, not once per bot.
+struct Simulation {
+    Grid&            grid;
+    PlayerParticle&  player;
+    BotSystem&       bots;
+    QuantumParticle& quantum;
+    QuantumEnsemble& qbots;
+    DistanceField&   finishField;
+    MazeStream*      stream;          //!< Endless mode when non-null
+
+    double        tickRate    = SIM_DEFAULT_TICK_RATE; //!< Ticks per simulated second
+    int           maxCatchUp  = SIM_MAX_CATCH_UP;      //!< Tick budget per advance()
+    double        accumulator = 0.0;  //!< Frame time not simulated yet, seconds
+    std::uint64_t ticks       = 0;    //!< Ticks run since construction
+    float         scrollTimer = 0.f;  //!< Time since the last stream scroll
+    bool          navigate    = false; //!< Bots steer along finishField each tick
+    CellIndex     botIndex;           //!< Bots by cell, rebuilt every tick
+
+    Simulation(Grid& grid, PlayerParticle& player, BotSystem& bots, QuantumParticle& quantum,
+               QuantumEnsemble& qbots, DistanceField& finishField, MazeStream* stream = nullptr);
+
+    /// Seconds of one tick
+    float tickSeconds() const { return static_cast<float>(1.0 / tickRate); }
+
+    /// One deterministic tick.  The quantum walkers only queue their step;
+    /// they are stepped and measured by the measure() that follows.
+    /// @return SimulationEvent flags raised during the tick
+    unsigned step(const SimulationInput& input);
+
+    /// Runs the quantum steps queued since the last call in one go
+    /// (QuantumParticle::fastForward) and measures every quantum walker;
+    /// no-op when no step is queued
+    /// @return SIM_OPPONENT_FINISHED when the quantum particle landed on
+    ///         the finish, else 0
+    unsigned measure();
+
+    /// Adds @p frameSeconds of wall-clock time and runs the ticks that are
+    /// due, each followed by measure(), stopping early at the first event
+    /// @return SimulationEvent flags of the ticks run and their measurements
+    unsigned advance(double frameSeconds, const SimulationInput& input);
+
+    /// How far the renderer is between the last two ticks, in [0, 1]
+    float alpha() const;
+
+    /// Records the current positions as the interpolation start; call it
+    /// after teleporting entities (resets) so nothing is drawn mid-jump
+    void snapshot();
+
+    /// Player position to draw this frame
+    sf::Vector2f playerDrawPosition() const;
+
+    /// Draws the bots at their interpolated positions
+    void drawBots(sf::RenderWindow& window) const;
+
+private:
+    bool               measurePending = false; //!< Quantum steps queued since measure()
+    sf::Vector2f       playerPrev;      //!< Player before the last tick
+    std::vector<float> botPrevX, botPrevY; //!< Bots before the last tick
+};
+
+#endif // SIMULATION_H
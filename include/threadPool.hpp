@@ -0,0 +1,69 @@
+// include/threadPool.hpp
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>  // worker wake-up
+#include <cstddef>             // std::size_t
+#include <cstdint>             // generations
+#include <functional>          // task callback
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Persistent worker threads for data-parallel loops.
+///
+/// Workers are started once and sleep between jobs, so a per-frame
+/// parallel step costs a wake-up, not a thread creation.  Tasks are dealt
+/// out statically: task t always runs on worker t % size() (worker 0 is
+/// the calling thread).  A row band is therefore always processed by the
+/// same thread, which is what keeps first-touch NUMA placement
+/// (firstTouchFill) valid from one step to the next.
+struct ThreadPool {
+    bool firstTouch = false;   //!< Place field pages on the worker that processes them
+
+    /// Starts @p threads − 1 workers (the caller is the last one);
+    /// 0 uses every hardware thread
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Threads taking part in run(), caller included
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    /// Runs task(0) … task(tasks − 1), task t on worker t % size(), and
+    /// returns when all are done.  Not reentrant.
+    void run(int tasks, const std::function<void(int)>& task);
+
+private:
+    void workerLoop(int index);
+    void runShare(int index);
+
+    std::vector<std::thread>         workers;
+    std::mutex                       mutex;
+    std::condition_variable          wake;        //!< New job or shutdown
+    std::condition_variable          finished;    //!< Last worker done
+    const std::function<void(int)>*  job      = nullptr;
+    int                              jobTasks = 0;
+    int                              busy     = 0;  //!< Workers still in the job
+    std::uint64_t                    generation = 0;
+    bool                             stopping = false;
+};
+
+/// Rows [first, last) of band @p band when @p height rows are split into
+/// @p bands nearly equal contiguous bands
+inline void bandRows(int band, int bands, int height, int& first, int& last)
+{
+    first = static_cast<int>(static_cast<long long>(height) * band / bands);
+    last  = static_cast<int>(static_cast<long long>(height) * (band + 1) / bands);
+}
+
+/// Fills @p count floats of a @p width-wide field with @p value, band by
+/// band on @p pool, after dropping the old pages (madvise DONTNEED) so the
+/// fill is their first touch.  On a NUMA machine every band then lives on
+/// the node of the worker that evolves it.  Without pool->firstTouch it is
+/// a plain fill.
+void firstTouchFill(float* data, std::size_t count, int width, float value, ThreadPool& pool);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,406 @@
+// =============================================================================
+// botSystem.cpp — Structure-of-arrays classical bots
+//
+// update() is one fused pass per bot: v += a·dt, then the swept move of
+// collision.cpp (cell DDA with bounces), reading walls from the cached
+// EvolveStencil exit masks (bit s set when side s is open).  The SIMD
+// kernels use the same separate multiply and add, comparisons and
+// truncating conversions as the scalar path, so all three agree bit for
+// bit.
+// =============================================================================
+
+#include "../include/botSystem.hpp"
+#include "../include/quantumKernels.hpp"  // evolveStencil (exit masks)
+#include "../include/collision.hpp"       // sweepCircle (scalar path)
+#include <algorithm>                      // std::min, std::max, std::clamp
+#include <cmath>                          // std::sqrt (steer)
+#include <cstdint>                        // std::uint8_t
+#include <iostream>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// keep v + a·dt unfused in the SIMD paths so they round like the scalar one
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BOT_KERNELS_X86 1
+#include <immintrin.h>         // AVX2 / AVX-512 intrinsics
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* storage                                                                   */
+/* ------------------------------------------------------------------------- */
+void BotSystem::reserve(std::size_t n)
+{
+    x.reserve(n);   y.reserve(n);
+    vx.reserve(n);  vy.reserve(n);
+    ax.reserve(n);  ay.reserve(n);
+    col.reserve(n); row.reserve(n);
+    color.reserve(n);
+}
+
+std::size_t BotSystem::add(sf::Vector2f position, int c, int r, sf::Color tint)
+{
+    x.push_back(position.x);  y.push_back(position.y);
+    vx.push_back(0.0f);       vy.push_back(0.0f);
+    ax.push_back(0.0f);       ay.push_back(0.0f);
+    col.push_back(c);         row.push_back(r);
+    color.push_back(tint);
+    return x.size() - 1;
+}
+
+void BotSystem::clear()
+{
+    x.clear();   y.clear();
+    vx.clear();  vy.clear();
+    ax.clear();  ay.clear();
+    col.clear(); row.clear();
+    color.clear();
+}
+
+void BotSystem::setPosition(std::size_t i, int newCol, int newRow, const Grid& grid)
+{
+    if (!indexIsValid(grid, newCol, newRow)) {
+        std::cout << "Invalid cell (" << newCol << "," << newRow << ")\n";
+        return;
+    }
+
+    int side = -1;
+    if      (newCol == col[i] + 1 && newRow == row[i]) side = SIDE_RIGHT;
+    else if (newCol == col[i] - 1 && newRow == row[i]) side = SIDE_LEFT;
+    else if (newRow == row[i] + 1 && newCol == col[i]) side = SIDE_DOWN;
+    else if (newRow == row[i] - 1 && newCol == col[i]) side = SIDE_TOP;
+    if (side < 0) return;                    // not a neighbour
+
+    if (grid.hasWall(col[i], row[i], side)) {
+        if (side == SIDE_LEFT || side == SIDE_RIGHT) vx[i] = -vx[i];
+        else                                         vy[i] = -vy[i];
+        return;
+    }
+
+    col[i] = newCol;
+    row[i] = newRow;
+    x[i] = (newCol + 0.5f) * NODE_SIZE;      // centre of the cell
+    y[i] = (newRow + 0.5f) * NODE_SIZE;
+}
+
+/* ------------------------------------------------------------------------- */
+/* update kernels                                                            */
+/* ------------------------------------------------------------------------- */
+static const float BOT_RADIUS = NODE_SIZE * 0.2f;   // ClassicalParticle::radius()
+
+/** Bots [begin, end) over @p dt, one sweepCircle() each */
+static void updateScalar(BotSystem& b, const EvolveStencil& s, float dt,
+                         std::size_t begin, std::size_t end)
+{
+    const float node = static_cast<float>(NODE_SIZE);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        sf::Vector2f position(b.x[i], b.y[i]);
+        sf::Vector2f velocity(b.vx[i] + b.ax[i] * dt, b.vy[i] + b.ay[i] * dt);
+        sweepCircle(s, position, velocity, dt, BOT_RADIUS, WallResponse::Bounce);
+
+        b.x[i]  = position.x;  b.y[i]  = position.y;
+        b.vx[i] = velocity.x;  b.vy[i] = velocity.y;
+        b.col[i] = static_cast<int>(position.x / node);
+        b.row[i] = static_cast<int>(position.y / node);
+    }
+}
+
+#ifdef BOT_KERNELS_X86
+/*
+ * The SIMD kernels run sweepCircle's event loop for 8 / 16 bots at once:
+ * every iteration resolves the next boundary event of each lane still
+ * moving, and the loop ends when no lane has time left.  Most steps need
+ * one or two iterations.
+ *
+ * The exit mask of a cell is fetched with a 32-bit gather of the aligned
+ * word holding its byte; EvolveStencil pads `exits` to whole words, so
+ * the word of the last cell lies inside the array.
+ */
+__attribute__((target("avx2")))
+static void updateAvx2(BotSystem& b, const EvolveStencil& s, float dt,
+                       std::size_t begin, std::size_t end)
+{
+    const __m256  node   = _mm256_set1_ps(static_cast<float>(NODE_SIZE));
+    const __m256  step   = _mm256_set1_ps(dt);
+    const __m256  zero   = _mm256_setzero_ps();
+    const __m256  never  = _mm256_set1_ps(__builtin_inff());
+    const __m256  radius = _mm256_set1_ps(BOT_RADIUS);
+    const __m256  sign   = _mm256_set1_ps(-0.0f);
+    const __m256i one    = _mm256_set1_epi32(1);
+    const __m256i izero  = _mm256_setzero_si256();
+    const __m256i maxC   = _mm256_set1_epi32(s.width - 1);
+    const __m256i maxR   = _mm256_set1_epi32(s.height - 1);
+    const __m256i w      = _mm256_set1_epi32(s.width);
+    const int*    words  = reinterpret_cast<const int*>(s.exits.data());
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 x  = _mm256_loadu_ps(&b.x[i]);
+        __m256 y  = _mm256_loadu_ps(&b.y[i]);
+        __m256 vx = _mm256_add_ps(_mm256_loadu_ps(&b.vx[i]), _mm256_mul_ps(_mm256_loadu_ps(&b.ax[i]), step));
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(&b.vy[i]), _mm256_mul_ps(_mm256_loadu_ps(&b.ay[i]), step));
+        __m256i col = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvttps_epi32(_mm256_div_ps(x, node)), izero), maxC);
+        __m256i row = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvttps_epi32(_mm256_div_ps(y, node)), izero), maxR);
+        __m256  rem = step;
+        __m256  active = _mm256_cmp_ps(rem, zero, _CMP_GT_OQ);
+
+        for (int event = 0; event < SWEEP_MAX_EVENTS && _mm256_movemask_ps(active); ++event)
+        {
+            const __m256i cell = _mm256_add_epi32(col, _mm256_mullo_epi32(row, w));
+            const __m256i word = _mm256_i32gather_epi32(words, _mm256_srli_epi32(cell, 2), 4);
+            const __m256i e    = _mm256_srlv_epi32(word,
+                _mm256_slli_epi32(_mm256_and_si256(cell, _mm256_set1_epi32(3)), 3));
+            auto closed = [&](int bit) {
+                const __m256i m = _mm256_set1_epi32(bit);
+                return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(e, m), izero));
+            };
+
+            // next x boundary: edge if open, wall face if walled
+            const __m256 right = _mm256_cmp_ps(vx, zero, _CMP_GT_OQ);
+            const __m256 left  = _mm256_cmp_ps(vx, zero, _CMP_LT_OQ);
+            const __m256 wallX = _mm256_or_ps(_mm256_and_ps(right, closed(1)), _mm256_and_ps(left, closed(4)));
+            const __m256 marginX = _mm256_and_ps(wallX, radius);
+            __m256 bx = _mm256_blendv_ps(x, _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(col, one)), node), marginX), right);
+            bx = _mm256_blendv_ps(bx, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(col), node), marginX), left);
+            __m256 tx = _mm256_blendv_ps(never, _mm256_div_ps(_mm256_sub_ps(bx, x), vx), _mm256_or_ps(right, left));
+
+            const __m256 down = _mm256_cmp_ps(vy, zero, _CMP_GT_OQ);
+            const __m256 up   = _mm256_cmp_ps(vy, zero, _CMP_LT_OQ);
+            const __m256 wallY = _mm256_or_ps(_mm256_and_ps(down, closed(2)), _mm256_and_ps(up, closed(8)));
+            const __m256 marginY = _mm256_and_ps(wallY, radius);
+            __m256 by = _mm256_blendv_ps(y, _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(row, one)), node), marginY), down);
+            by = _mm256_blendv_ps(by, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(row), node), marginY), up);
+            __m256 ty = _mm256_blendv_ps(never, _mm256_div_ps(_mm256_sub_ps(by, y), vy), _mm256_or_ps(down, up));
+
+            tx = _mm256_max_ps(tx, zero);
+            ty = _mm256_max_ps(ty, zero);
+
+            // lanes whose step ends before any boundary
+            const __m256 finish = _mm256_and_ps(active, _mm256_and_ps(_mm256_cmp_ps(tx, rem, _CMP_GE_OQ),
+                                                                      _mm256_cmp_ps(ty, rem, _CMP_GE_OQ)));
+            x   = _mm256_blendv_ps(x, _mm256_add_ps(x, _mm256_mul_ps(vx, rem)), finish);
+            y   = _mm256_blendv_ps(y, _mm256_add_ps(y, _mm256_mul_ps(vy, rem)), finish);
+            rem = _mm256_blendv_ps(rem, zero, finish);
+
+            const __m256 pending = _mm256_andnot_ps(finish, active);
+            const __m256 evX = _mm256_and_ps(pending, _mm256_cmp_ps(tx, ty, _CMP_LE_OQ));
+            const __m256 evY = _mm256_andnot_ps(evX, pending);
+
+            // x boundary first
+            y   = _mm256_blendv_ps(y, _mm256_add_ps(y, _mm256_mul_ps(vy, tx)), evX);
+            x   = _mm256_blendv_ps(x, bx, evX);
+            rem = _mm256_blendv_ps(rem, _mm256_sub_ps(rem, tx), evX);
+            vx  = _mm256_xor_ps(vx, _mm256_and_ps(_mm256_and_ps(evX, wallX), sign));
+            const __m256i crossX = _mm256_castps_si256(_mm256_andnot_ps(wallX, evX));
+            col = _mm256_sub_epi32(col, _mm256_and_si256(crossX, _mm256_castps_si256(right)));  // -(-1)
+            col = _mm256_add_epi32(col, _mm256_and_si256(crossX, _mm256_castps_si256(left)));   // +(-1)
+
+            // y boundary first
+            x   = _mm256_blendv_ps(x, _mm256_add_ps(x, _mm256_mul_ps(vx, ty)), evY);
+            y   = _mm256_blendv_ps(y, by, evY);
+            rem = _mm256_blendv_ps(rem, _mm256_sub_ps(rem, ty), evY);
+            vy  = _mm256_xor_ps(vy, _mm256_and_ps(_mm256_and_ps(evY, wallY), sign));
+            const __m256i crossY = _mm256_castps_si256(_mm256_andnot_ps(wallY, evY));
+            row = _mm256_sub_epi32(row, _mm256_and_si256(crossY, _mm256_castps_si256(down)));
+            row = _mm256_add_epi32(row, _mm256_and_si256(crossY, _mm256_castps_si256(up)));
+
+            active = _mm256_and_ps(pending, _mm256_cmp_ps(rem, zero, _CMP_GT_OQ));
+        }
+
+        _mm256_storeu_ps(&b.vx[i], vx);
+        _mm256_storeu_ps(&b.vy[i], vy);
+        _mm256_storeu_ps(&b.x[i],  x);
+        _mm256_storeu_ps(&b.y[i],  y);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&b.col[i]), _mm256_cvttps_epi32(_mm256_div_ps(x, node)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&b.row[i]), _mm256_cvttps_epi32(_mm256_div_ps(y, node)));
+    }
+    updateScalar(b, s, dt, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void updateAvx512(BotSystem& b, const EvolveStencil& s, float dt,
+                         std::size_t begin, std::size_t end)
+{
+    const __m512  node   = _mm512_set1_ps(static_cast<float>(NODE_SIZE));
+    const __m512  step   = _mm512_set1_ps(dt);
+    const __m512  zero   = _mm512_setzero_ps();
+    const __m512  never  = _mm512_set1_ps(__builtin_inff());
+    const __m512  radius = _mm512_set1_ps(BOT_RADIUS);
+    const __m512i sign   = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+    const __m512i one    = _mm512_set1_epi32(1);
+    const __m512i izero  = _mm512_setzero_si512();
+    const __m512i maxC   = _mm512_set1_epi32(s.width - 1);
+    const __m512i maxR   = _mm512_set1_epi32(s.height - 1);
+    const __m512i w      = _mm512_set1_epi32(s.width);
+    const std::uint8_t* exits = s.exits.data();
+
+    std::size_t i = begin;
+    for (; i + 16 <= end; i += 16)
+    {
+        __m512 x  = _mm512_loadu_ps(&b.x[i]);
+        __m512 y  = _mm512_loadu_ps(&b.y[i]);
+        __m512 vx = _mm512_add_ps(_mm512_loadu_ps(&b.vx[i]), _mm512_mul_ps(_mm512_loadu_ps(&b.ax[i]), step));
+        __m512 vy = _mm512_add_ps(_mm512_loadu_ps(&b.vy[i]), _mm512_mul_ps(_mm512_loadu_ps(&b.ay[i]), step));
+        __m512i col = _mm512_min_epi32(_mm512_max_epi32(_mm512_cvttps_epi32(_mm512_div_ps(x, node)), izero), maxC);
+        __m512i row = _mm512_min_epi32(_mm512_max_epi32(_mm512_cvttps_epi32(_mm512_div_ps(y, node)), izero), maxR);
+        __m512  rem = step;
+        __mmask16 active = _mm512_cmp_ps_mask(rem, zero, _CMP_GT_OQ);
+
+        for (int event = 0; event < SWEEP_MAX_EVENTS && active; ++event)
+        {
+            const __m512i cell = _mm512_add_epi32(col, _mm512_mullo_epi32(row, w));
+            const __m512i word = _mm512_i32gather_epi32(_mm512_srli_epi32(cell, 2), exits, 4);
+            const __m512i e    = _mm512_srlv_epi32(word,
+                _mm512_slli_epi32(_mm512_and_si512(cell, _mm512_set1_epi32(3)), 3));
+
+            // next x boundary: edge if open, wall face if walled
+            const __mmask16 right = _mm512_cmp_ps_mask(vx, zero, _CMP_GT_OQ);
+            const __mmask16 left  = _mm512_cmp_ps_mask(vx, zero, _CMP_LT_OQ);
+            const __mmask16 wallX = (right & _mm512_testn_epi32_mask(e, _mm512_set1_epi32(1))) |
+                                    (left  & _mm512_testn_epi32_mask(e, _mm512_set1_epi32(4)));
+            const __m512 marginX = _mm512_maskz_mov_ps(wallX, radius);
+            __m512 bx = _mm512_mask_sub_ps(x, right, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(col, one)), node), marginX);
+            bx = _mm512_mask_add_ps(bx, left, _mm512_mul_ps(_mm512_cvtepi32_ps(col), node), marginX);
+            __m512 tx = _mm512_mask_div_ps(never, right | left, _mm512_sub_ps(bx, x), vx);
+
+            const __mmask16 down  = _mm512_cmp_ps_mask(vy, zero, _CMP_GT_OQ);
+            const __mmask16 up    = _mm512_cmp_ps_mask(vy, zero, _CMP_LT_OQ);
+            const __mmask16 wallY = (down & _mm512_testn_epi32_mask(e, _mm512_set1_epi32(2))) |
+                                    (up   & _mm512_testn_epi32_mask(e, _mm512_set1_epi32(8)));
+            const __m512 marginY = _mm512_maskz_mov_ps(wallY, radius);
+            __m512 by = _mm512_mask_sub_ps(y, down, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(row, one)), node), marginY);
+            by = _mm512_mask_add_ps(by, up, _mm512_mul_ps(_mm512_cvtepi32_ps(row), node), marginY);
+            __m512 ty = _mm512_mask_div_ps(never, down | up, _mm512_sub_ps(by, y), vy);
+
+            tx = _mm512_max_ps(tx, zero);
+            ty = _mm512_max_ps(ty, zero);
+
+            // lanes whose step ends before any boundary
+            const __mmask16 finish = active & _mm512_cmp_ps_mask(tx, rem, _CMP_GE_OQ)
+                                            & _mm512_cmp_ps_mask(ty, rem, _CMP_GE_OQ);
+            x   = _mm512_mask_add_ps(x, finish, x, _mm512_mul_ps(vx, rem));
+            y   = _mm512_mask_add_ps(y, finish, y, _mm512_mul_ps(vy, rem));
+            rem = _mm512_mask_mov_ps(rem, finish, zero);
+
+            const __mmask16 pending = active & ~finish;
+            const __mmask16 evX = pending & _mm512_cmp_ps_mask(tx, ty, _CMP_LE_OQ);
+            const __mmask16 evY = pending & ~evX;
+
+            // x boundary first
+            y   = _mm512_mask_add_ps(y, evX, y, _mm512_mul_ps(vy, tx));
+            x   = _mm512_mask_mov_ps(x, evX, bx);
+            rem = _mm512_mask_sub_ps(rem, evX, rem, tx);
+            vx  = _mm512_castsi512_ps(_mm512_mask_xor_epi32(_mm512_castps_si512(vx), evX & wallX,
+                                                            _mm512_castps_si512(vx), sign));
+            col = _mm512_mask_add_epi32(col, evX & ~wallX & right, col, one);
+            col = _mm512_mask_sub_epi32(col, evX & ~wallX & left,  col, one);
+
+            // y boundary first
+            x   = _mm512_mask_add_ps(x, evY, x, _mm512_mul_ps(vx, ty));
+            y   = _mm512_mask_mov_ps(y, evY, by);
+            rem = _mm512_mask_sub_ps(rem, evY, rem, ty);
+            vy  = _mm512_castsi512_ps(_mm512_mask_xor_epi32(_mm512_castps_si512(vy), evY & wallY,
+                                                            _mm512_castps_si512(vy), sign));
+            row = _mm512_mask_add_epi32(row, evY & ~wallY & down, row, one);
+            row = _mm512_mask_sub_epi32(row, evY & ~wallY & up,   row, one);
+
+            active = pending & _mm512_cmp_ps_mask(rem, zero, _CMP_GT_OQ);
+        }
+
+        _mm512_storeu_ps(&b.vx[i], vx);
+        _mm512_storeu_ps(&b.vy[i], vy);
+        _mm512_storeu_ps(&b.x[i],  x);
+        _mm512_storeu_ps(&b.y[i],  y);
+        _mm512_storeu_si512(&b.col[i], _mm512_cvttps_epi32(_mm512_div_ps(x, node)));
+        _mm512_storeu_si512(&b.row[i], _mm512_cvttps_epi32(_mm512_div_ps(y, node)));
+    }
+    updateScalar(b, s, dt, i, end);
+}
+#endif // BOT_KERNELS_X86
+
+using BotKernel = void (*)(BotSystem&, const EvolveStencil&, float, std::size_t, std::size_t);
+
+static BotKernel botKernel()
+{
+    static const BotKernel chosen = []() -> BotKernel {
+#ifdef BOT_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return updateAvx512;
+        if (__builtin_cpu_supports("avx2"))    return updateAvx2;
+#endif
+        return updateScalar;
+    }();
+    return chosen;
+}
+
+/* ------------------------------------------------------------------------- */
+/* update / scroll / queries                                                 */
+/* ------------------------------------------------------------------------- */
+void BotSystem::update(float dt, const Grid& grid)
+{
+    if (empty()) return;
+    botKernel()(*this, evolveStencil(grid), dt, 0, size());   // exit masks, cached per maze
+}
+
+void BotSystem::steer(const DistanceField& field, float speed)
+{
+    if (!field.isValid()) return;
+    const float node = static_cast<float>(NODE_SIZE);
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        const int c = col[i], r = row[i];
+        if (c < 0 || c >= field.width || r < 0 || r >= field.height) continue;
+        if (field.at(c, r) == DistanceField::UNREACHABLE) continue;
+
+        // aim at the centre of the next cell (of this one at the finish);
+        // the line there crosses the open side, never a wall
+        const int side = field.stepToward(c, r);
+        const int tc = side < 0 ? c : nextCol(c, side);
+        const int tr = side < 0 ? r : nextRow(r, side);
+        const float dx = (tc + 0.5f) * node - x[i];
+        const float dy = (tr + 0.5f) * node - y[i];
+        const float len = std::sqrt(dx * dx + dy * dy);
+        const float k = len > 1e-3f ? speed / len : 0.0f;
+        vx[i] = dx * k;
+        vy[i] = dy * k;
+    }
+}
+
+void BotSystem::scroll(int rows)
+{
+    const float radius = NODE_SIZE * 0.2f;
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        y[i]   -= rows * NODE_SIZE;
+        row[i] -= rows;
+        if (row[i] < 0) {                    // pushed off the top edge
+            row[i] = 0;
+            y[i]   = std::max(y[i], radius);
+        }
+    }
+}
+
+void BotSystem::draw(sf::RenderWindow& window) const
+{
+    draw(window, x, y, 1.0f);
+}
+
+void BotSystem::draw(sf::RenderWindow& window, const std::vector<float>& fromX,
+                     const std::vector<float>& fromY, float alpha) const
+{
+    const bool  lerp = fromX.size() == size() && fromY.size() == size();
+    const float r = NODE_SIZE * 0.2f;         // ball radius
+    sf::CircleShape shape(r);
+    shape.setOrigin(sf::Vector2f{r, r});      // position is the CENTER
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        const float px = lerp ? fromX[i] + (x[i] - fromX[i]) * alpha : x[i];
+        const float py = lerp ? fromY[i] + (y[i] - fromY[i]) * alpha : y[i];
+        shape.setFillColor(color[i]);
+        shape.setPosition(sf::Vector2f{px, py});
+        window.draw(shape);
+    }
+}
@@ -0,0 +1,132 @@
+// =============================================================================
+// cellIndex.cpp — Per-cell bot index, counting-sorted every tick
+// =============================================================================
+
+#include "../include/cellIndex.hpp"
+#include <algorithm>              // std::max, std::min
+#include <cmath>                  // std::floor
+
+/* ------------------------------------------------------------------------- */
+/* rebuild                                                                   */
+/* ------------------------------------------------------------------------- */
+/** Counting sort in three linear passes.  The bucket of every bot is kept
+ *  from the counting pass so the scatter pass does not hash again.
+ */
+void CellIndex::rebuild(const BotSystem& bots, int w, int h)
+{
+    width  = w;
+    height = h;
+    const std::size_t n = bots.size();
+
+    unsigned bits = 0;
+    while ((std::size_t{1} << bits) < std::max<std::size_t>(n, CELL_INDEX_MIN_BUCKETS))
+        ++bits;
+    shift = 32 - bits;
+    const std::uint32_t buckets = std::uint32_t{1} << bits;
+    const std::uint32_t outside = buckets;                  // sentinel bucket
+
+    // count
+    start.assign(buckets + 1, 0);
+    bucketOf.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const int c = bots.col[i], r = bots.row[i];
+        if (c < 0 || c >= width || r < 0 || r >= height) {
+            bucketOf[i] = outside;
+            continue;
+        }
+        bucketOf[i] = bucket(c + r * width);
+        ++start[bucketOf[i] + 1];
+    }
+
+    // prefix sum
+    for (std::uint32_t b = 0; b < buckets; ++b)
+        start[b + 1] += start[b];
+
+    // scatter, stable in bot index
+    items.resize(start[buckets]);
+    cells.resize(start[buckets]);
+    fill.assign(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::uint32_t b = bucketOf[i];
+        if (b == outside) continue;
+        const std::uint32_t k = fill[b]++;
+        items[k] = static_cast<std::uint32_t>(i);
+        cells[k] = bots.col[i] + bots.row[i] * width;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* queries                                                                   */
+/* ------------------------------------------------------------------------- */
+bool CellIndex::any(int col, int row) const
+{
+    if (start.empty() || col < 0 || col >= width || row < 0 || row >= height)
+        return false;
+    const int cell = col + row * width;
+    const std::uint32_t b = bucket(cell);
+    for (std::uint32_t k = start[b]; k < start[b + 1]; ++k)
+        if (cells[k] == cell)
+            return true;
+    return false;
+}
+
+std::size_t CellIndex::inCell(int col, int row, std::vector<std::uint32_t>& out) const
+{
+    if (start.empty() || col < 0 || col >= width || row < 0 || row >= height)
+        return 0;
+    const std::size_t before = out.size();
+    const int cell = col + row * width;
+    const std::uint32_t b = bucket(cell);
+    for (std::uint32_t k = start[b]; k < start[b + 1]; ++k)
+        if (cells[k] == cell)
+            out.push_back(items[k]);
+    return out.size() - before;
+}
+
+std::size_t CellIndex::within(const BotSystem& bots, sf::Vector2f centre, float radius,
+                              std::vector<std::uint32_t>& out) const
+{
+    if (start.empty() || radius < 0.0f)
+        return 0;
+    const std::size_t before = out.size();
+    const float r2 = radius * radius;
+    auto close = [&](std::uint32_t i) {
+        const float dx = bots.x[i] - centre.x, dy = bots.y[i] - centre.y;
+        return dx * dx + dy * dy <= r2;
+    };
+
+    // cells overlapped by the bounding square, clipped to the grid
+    const float node = static_cast<float>(NODE_SIZE);
+    const int c0 = std::max(0, static_cast<int>(std::floor((centre.x - radius) / node)));
+    const int r0 = std::max(0, static_cast<int>(std::floor((centre.y - radius) / node)));
+    const int c1 = std::min(width - 1,  static_cast<int>(std::floor((centre.x + radius) / node)));
+    const int r1 = std::min(height - 1, static_cast<int>(std::floor((centre.y + radius) / node)));
+    if (c0 > c1 || r0 > r1)
+        return 0;
+
+    const double covered = double(c1 - c0 + 1) * double(r1 - r0 + 1);
+    if (covered > static_cast<double>(items.size()))
+    {
+        // a wide radius: one pass over the index beats walking empty cells
+        for (std::size_t k = 0; k < items.size(); ++k)
+        {
+            const int c = cells[k] % width, r = cells[k] / width;
+            if (c >= c0 && c <= c1 && r >= r0 && r <= r1 && close(items[k]))
+                out.push_back(items[k]);
+        }
+        return out.size() - before;
+    }
+
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c)
+        {
+            const int cell = c + r * width;
+            const std::uint32_t b = bucket(cell);
+            for (std::uint32_t k = start[b]; k < start[b + 1]; ++k)
+                if (cells[k] == cell && close(items[k]))
+                    out.push_back(items[k]);
+        }
+    return out.size() - before;
+}
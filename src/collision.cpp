@@ -0,0 +1,92 @@
+// =============================================================================
+// collision.cpp — Swept-circle motion through the maze (cell DDA)
+//
+// The BotSystem SIMD kernels run the same event loop lane by lane; keep the
+// operation order here in step with them (separate multiply and add, the
+// same comparisons) so both stay bit-identical.
+// =============================================================================
+
+#include "../include/collision.hpp"
+#include <algorithm>           // std::clamp, std::max
+#include <limits>              // infinity
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+int sweepCircle(const EvolveStencil& stencil, sf::Vector2f& position, sf::Vector2f& velocity,
+                float dt, float radius, WallResponse response)
+{
+    const float node   = static_cast<float>(NODE_SIZE);
+    const float never  = std::numeric_limits<float>::infinity();
+    const int   width  = stencil.width;
+    const bool  bounce = response == WallResponse::Bounce;
+
+    float x = position.x, y = position.y;
+    float vx = velocity.x, vy = velocity.y;
+    int   col = std::clamp(static_cast<int>(x / node), 0, width - 1);
+    int   row = std::clamp(static_cast<int>(y / node), 0, stencil.height - 1);
+    float remaining = dt;
+    int   contacts  = 0;
+
+    for (int event = 0; event < SWEEP_MAX_EVENTS && remaining > 0.0f; ++event)
+    {
+        const std::uint8_t e = stencil.exits[col + row * width];
+
+        // time to the next x / y boundary: the cell edge if open, the
+        // wall face (radius inside the edge) if walled
+        float tx = never, bx = x;
+        bool  wallX = false;
+        if (vx > 0.0f) {
+            wallX = !(e & 1u);                                   // RIGHT
+            bx = static_cast<float>(col + 1) * node - (wallX ? radius : 0.0f);
+            tx = (bx - x) / vx;
+        } else if (vx < 0.0f) {
+            wallX = !(e & 4u);                                   // LEFT
+            bx = static_cast<float>(col) * node + (wallX ? radius : 0.0f);
+            tx = (bx - x) / vx;
+        }
+        float ty = never, by = y;
+        bool  wallY = false;
+        if (vy > 0.0f) {
+            wallY = !(e & 2u);                                   // DOWN
+            by = static_cast<float>(row + 1) * node - (wallY ? radius : 0.0f);
+            ty = (by - y) / vy;
+        } else if (vy < 0.0f) {
+            wallY = !(e & 8u);                                   // TOP
+            by = static_cast<float>(row) * node + (wallY ? radius : 0.0f);
+            ty = (by - y) / vy;
+        }
+        tx = std::max(0.0f, tx);             // already past it: the event is now
+        ty = std::max(0.0f, ty);             // (max(0,t) maps -0 and NaN to 0, as maxps)
+
+        if (tx >= remaining && ty >= remaining)
+        {
+            x = x + vx * remaining;          // no boundary before the step ends
+            y = y + vy * remaining;
+            remaining = 0.0f;
+            break;
+        }
+
+        if (tx <= ty)
+        {
+            y = y + vy * tx;
+            x = bx;
+            remaining = remaining - tx;
+            if (wallX) { vx = bounce ? -vx : 0.0f; ++contacts; }
+            else       col += vx > 0.0f ? 1 : -1;
+        }
+        else
+        {
+            x = x + vx * ty;
+            y = by;
+            remaining = remaining - ty;
+            if (wallY) { vy = bounce ? -vy : 0.0f; ++contacts; }
+            else       row += vy > 0.0f ? 1 : -1;
+        }
+    }
+
+    position = sf::Vector2f(x, y);
+    velocity = sf::Vector2f(vx, vy);
+    return contacts;
+}
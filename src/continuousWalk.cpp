@@ -0,0 +1,319 @@
+// =============================================================================
+// continuousWalk.cpp — Continuous-time quantum walk, Chebyshev propagator
+// =============================================================================
+
+#include "../include/continuousWalk.hpp"
+#include "../include/quantumKernels.hpp"  // evolveStencil (exit masks)
+#include <algorithm>                      // std::clamp, std::max, std::fill
+#include <cmath>                          // std::cbrt, std::ceil, std::cos, std::sin
+#include <cstring>                        // std::memcpy
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CTQW_KERNELS_X86 1
+#include <immintrin.h>                    // AVX2 / AVX-512 intrinsics
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* Bessel coefficients                                                       */
+/* ------------------------------------------------------------------------- */
+/** J_0(x) … J_K(x) by Miller's backward recurrence
+ *      J_{k-1} = (2k/x) J_k − J_{k+1},
+ *  started well above the orders we keep and normalised with
+ *  J_0 + 2 Σ J_{2k} = 1.  Stable for every order, unlike the forward
+ *  recurrence past k ≈ x.  K is the first order above x whose term
+ *  2|J_K| drops under @p tol.
+ */
+static void besselSeries(double x, double tol, std::vector<double>& out)
+{
+    if (x < 1e-12)
+    {
+        out.assign(1, 1.0);
+        return;
+    }
+
+    const int keep  = static_cast<int>(std::ceil(x + 30.0 + 15.0 * std::cbrt(x)));
+    const int start = keep + 30;
+    std::vector<double> j(start + 2, 0.0);
+    j[start] = 1e-30;
+    for (int k = start; k > 0; --k)
+    {
+        j[k - 1] = (2.0 * k / x) * j[k] - j[k + 1];
+        if (std::fabs(j[k - 1]) > 1e250)           // rescale, only ratios matter
+            for (int m = k - 1; m <= start; ++m) j[m] *= 1e-250;
+    }
+
+    double norm = j[0];
+    for (int k = 2; k <= start; k += 2) norm += 2.0 * j[k];
+
+    out.clear();
+    for (int k = 0; k <= keep; ++k)
+    {
+        out.push_back(j[k] / norm);
+        if (k > x && 2.0 * std::fabs(out.back()) < tol) break;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* operator                                                                  */
+/* ------------------------------------------------------------------------- */
+struct ScaledHamiltonian {
+    const std::uint8_t* exits;
+    int    width;
+    int    cells;
+    bool   laplacian;
+    double centre;     // a
+    double halfWidth;  // b
+};
+
+struct ComplexPlanes {
+    double* re;
+    double* im;
+};
+
+/** out = s · (H − a)v − beta · prev on cells [begin,end), both planes of a
+ *  complex vector in one sweep.  Branch-free: a closed side reads the cell
+ *  itself with weight 0, so the random wall layout costs no mispredictions
+ *  and needs no bounds checks.
+ */
+static void applySpanScalar(const ScaledHamiltonian& h, ComplexPlanes v, ComplexPlanes prev,
+                            double s, double beta, ComplexPlanes out, int begin, int end)
+{
+    const int w = h.width;
+    for (int i = begin; i < end; ++i)
+    {
+        const int    e  = h.exits[i];
+        const int    r  = i + ( 1 & -( e       & 1));   // neighbour, or i if closed
+        const int    d  = i + ( w & -((e >> 1) & 1));
+        const int    l  = i + (-1 & -((e >> 2) & 1));
+        const int    u  = i + (-w & -((e >> 3) & 1));
+        const double wr = e & 1, wd = (e >> 1) & 1, wl = (e >> 2) & 1, wu = (e >> 3) & 1;
+        const double diag = (h.laplacian ? wr + wd + wl + wu : 0.0) - h.centre;
+
+        const double sumRe = wr * v.re[r] + wd * v.re[d] + wl * v.re[l] + wu * v.re[u];
+        const double sumIm = wr * v.im[r] + wd * v.im[d] + wl * v.im[l] + wu * v.im[u];
+        out.re[i] = s * (diag * v.re[i] - sumRe) - beta * prev.re[i];
+        out.im[i] = s * (diag * v.im[i] - sumIm) - beta * prev.im[i];
+    }
+}
+
+#ifdef CTQW_KERNELS_X86
+/** AVX2: 4 cells per iteration, closed sides masked out of the loads */
+__attribute__((target("avx2,fma")))
+static void applySpanAvx2(const ScaledHamiltonian& h, ComplexPlanes v, ComplexPlanes prev,
+                          double s, double beta, ComplexPlanes out, int begin, int end)
+{
+    const int     w       = h.width;
+    const int     offset[4] = { 1, w, -1, -w };
+    const __m256d vs      = _mm256_set1_pd(s);
+    const __m256d vbeta   = _mm256_set1_pd(beta);
+    const __m256d centre  = _mm256_set1_pd(h.centre);
+    const __m256d lap     = _mm256_set1_pd(h.laplacian ? 1.0 : 0.0);
+    const __m256d one     = _mm256_set1_pd(1.0);
+    int i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        std::uint32_t bytes;
+        std::memcpy(&bytes, h.exits + i, 4);
+        const __m256i e = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(bytes)));
+        __m256d sumRe = _mm256_setzero_pd(), sumIm = _mm256_setzero_pd(), deg = _mm256_setzero_pd();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __m256i bit  = _mm256_set1_epi64x(1 << side);
+            const __m256i open = _mm256_cmpeq_epi64(_mm256_and_si256(e, bit), bit);
+            sumRe = _mm256_add_pd(sumRe, _mm256_maskload_pd(v.re + i + offset[side], open));
+            sumIm = _mm256_add_pd(sumIm, _mm256_maskload_pd(v.im + i + offset[side], open));
+            deg   = _mm256_add_pd(deg, _mm256_and_pd(_mm256_castsi256_pd(open), one));
+        }
+        const __m256d diag = _mm256_fmsub_pd(lap, deg, centre);
+        const __m256d re   = _mm256_fmsub_pd(diag, _mm256_loadu_pd(v.re + i), sumRe);
+        const __m256d im   = _mm256_fmsub_pd(diag, _mm256_loadu_pd(v.im + i), sumIm);
+        _mm256_storeu_pd(out.re + i, _mm256_fnmadd_pd(vbeta, _mm256_loadu_pd(prev.re + i), _mm256_mul_pd(vs, re)));
+        _mm256_storeu_pd(out.im + i, _mm256_fnmadd_pd(vbeta, _mm256_loadu_pd(prev.im + i), _mm256_mul_pd(vs, im)));
+    }
+    applySpanScalar(h, v, prev, s, beta, out, i, end);
+}
+
+/** AVX-512: 8 cells per iteration, closed sides zero-masked out of the loads */
+__attribute__((target("avx512f")))
+static void applySpanAvx512(const ScaledHamiltonian& h, ComplexPlanes v, ComplexPlanes prev,
+                            double s, double beta, ComplexPlanes out, int begin, int end)
+{
+    const int     w       = h.width;
+    const int     offset[4] = { 1, w, -1, -w };
+    const __m512d vs      = _mm512_set1_pd(s);
+    const __m512d vbeta   = _mm512_set1_pd(beta);
+    const __m512d centre  = _mm512_set1_pd(h.centre);
+    const __m512d lap     = _mm512_set1_pd(h.laplacian ? 1.0 : 0.0);
+    const __m512d one     = _mm512_set1_pd(1.0);
+    int i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m512i e = _mm512_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(h.exits + i)));
+        __m512d sumRe = _mm512_setzero_pd(), sumIm = _mm512_setzero_pd(), deg = _mm512_setzero_pd();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __mmask8 open = _mm512_test_epi64_mask(e, _mm512_set1_epi64(1 << side));
+            sumRe = _mm512_add_pd(sumRe, _mm512_maskz_loadu_pd(open, v.re + i + offset[side]));
+            sumIm = _mm512_add_pd(sumIm, _mm512_maskz_loadu_pd(open, v.im + i + offset[side]));
+            deg   = _mm512_mask_add_pd(deg, open, deg, one);
+        }
+        const __m512d diag = _mm512_fmsub_pd(lap, deg, centre);
+        const __m512d re   = _mm512_fmsub_pd(diag, _mm512_loadu_pd(v.re + i), sumRe);
+        const __m512d im   = _mm512_fmsub_pd(diag, _mm512_loadu_pd(v.im + i), sumIm);
+        _mm512_storeu_pd(out.re + i, _mm512_fnmadd_pd(vbeta, _mm512_loadu_pd(prev.re + i), _mm512_mul_pd(vs, re)));
+        _mm512_storeu_pd(out.im + i, _mm512_fnmadd_pd(vbeta, _mm512_loadu_pd(prev.im + i), _mm512_mul_pd(vs, im)));
+    }
+    applySpanScalar(h, v, prev, s, beta, out, i, end);
+}
+#endif // CTQW_KERNELS_X86
+
+using ApplySpan = void (*)(const ScaledHamiltonian&, ComplexPlanes, ComplexPlanes,
+                           double, double, ComplexPlanes, int, int);
+
+static ApplySpan applySpanKernel()
+{
+    static const ApplySpan chosen = []() -> ApplySpan {
+#ifdef CTQW_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return applySpanAvx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return applySpanAvx2;
+#endif
+        return applySpanScalar;
+    }();
+    return chosen;
+}
+
+/** out = alpha · H'v − beta · prev, H' = (H − a)/b.  The SIMD kernels
+ *  cover the rows whose every neighbour lies inside the planes; the first
+ *  and last rows take the scalar path.
+ */
+static void applyScaled(const ScaledHamiltonian& h, ComplexPlanes v, ComplexPlanes prev,
+                        double alpha, double beta, ComplexPlanes out)
+{
+    const int    w = h.width;
+    const double s = alpha / h.halfWidth;
+    if (h.cells <= 2 * w)
+    {
+        applySpanScalar(h, v, prev, s, beta, out, 0, h.cells);
+        return;
+    }
+    applySpanScalar(h, v, prev, s, beta, out, 0, w);
+    applySpanKernel()(h, v, prev, s, beta, out, w, h.cells - w);
+    applySpanScalar(h, v, prev, s, beta, out, h.cells - w, h.cells);
+}
+
+/** acc += 2 J (−i)^k (tre + i·tim) */
+static void accumulate(int k, double coeff, const double* tre, const double* tim,
+                       double* accRe, double* accIm, int cells)
+{
+    const double c = 2.0 * coeff;
+    switch (k & 3)
+    {
+        case 0: for (int i = 0; i < cells; ++i) { accRe[i] += c * tre[i]; accIm[i] += c * tim[i]; } break;
+        case 1: for (int i = 0; i < cells; ++i) { accRe[i] += c * tim[i]; accIm[i] -= c * tre[i]; } break;
+        case 2: for (int i = 0; i < cells; ++i) { accRe[i] -= c * tre[i]; accIm[i] -= c * tim[i]; } break;
+        case 3: for (int i = 0; i < cells; ++i) { accRe[i] -= c * tim[i]; accIm[i] += c * tre[i]; } break;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* ContinuousWalk                                                            */
+/* ------------------------------------------------------------------------- */
+void ContinuousWalk::initializeAt(const Grid& grid, int col, int row)
+{
+    width  = grid.width;
+    height = grid.height;
+    time   = 0.0;
+    re.assign(grid.cellCount(), 0.0);
+    im.assign(grid.cellCount(), 0.0);
+    re[grid.index(std::clamp(col, 0, width - 1), std::clamp(row, 0, height - 1))] = 1.0;
+}
+
+int ContinuousWalk::evolve(const Grid& grid, double t)
+{
+    if (width != grid.width || height != grid.height)
+        initializeAt(grid, grid.width / 2, grid.height / 2);   // grid was resized under us
+    if (t == 0.0) return 0;
+
+    const EvolveStencil& stencil = evolveStencil(grid);
+    const int cells = grid.cellCount();
+
+    // Gershgorin interval of H: the largest degree bounds both ends
+    int maxDegree = 0;
+    for (int i = 0; i < cells; ++i)
+        maxDegree = std::max(maxDegree, __builtin_popcount(stencil.exits[i]));
+    time += t;
+    if (maxDegree == 0) return 0;                // no edges: H = 0
+
+    ScaledHamiltonian h;
+    h.exits     = stencil.exits.data();
+    h.width     = width;
+    h.cells     = cells;
+    h.laplacian = hamiltonian == CtqwHamiltonian::Laplacian;
+    h.centre    = h.laplacian ? maxDegree : 0.0;
+    h.halfWidth = maxDegree;
+
+    t0re.resize(cells); t0im.resize(cells);
+    t1re.resize(cells); t1im.resize(cells);
+    t2re.resize(cells); t2im.resize(cells);
+
+    const double phase  = h.halfWidth * std::fabs(t);
+    const int    slices = std::max(1, static_cast<int>(std::ceil(phase / CTQW_MAX_SLICE_PHASE)));
+    const double dt     = t / slices;
+    besselSeries(h.halfWidth * std::fabs(dt), tolerance / slices, bessel);
+    const double sign   = dt < 0.0 ? -1.0 : 1.0; // exp(+iHt) = conj series: flip (−i)^k
+
+    int products = 0;
+    for (int slice = 0; slice < slices; ++slice)
+    {
+        // T_0 = ψ; the result accumulates in re/im
+        t0re.swap(re); t0im.swap(im);
+        for (int i = 0; i < cells; ++i) { re[i] = bessel[0] * t0re[i]; im[i] = bessel[0] * t0im[i]; }
+
+        const int terms = static_cast<int>(bessel.size());
+        if (terms > 1)
+        {
+            // T_1 = H'ψ
+            const ComplexPlanes t0{ t0re.data(), t0im.data() };
+            applyScaled(h, t0, t0, 1.0, 0.0, { t1re.data(), t1im.data() });
+            accumulate(sign > 0 ? 1 : 3, bessel[1], t1re.data(), t1im.data(), re.data(), im.data(), cells);
+            ++products;
+        }
+        for (int k = 2; k < terms; ++k)
+        {
+            // T_{k+1} = 2H'T_k − T_{k−1}
+            applyScaled(h, { t1re.data(), t1im.data() }, { t0re.data(), t0im.data() },
+                        2.0, 1.0, { t2re.data(), t2im.data() });
+            accumulate(sign > 0 ? k : (4 - (k & 3)) & 3, bessel[k], t2re.data(), t2im.data(),
+                       re.data(), im.data(), cells);
+            t0re.swap(t1re); t0im.swap(t1im);
+            t1re.swap(t2re); t1im.swap(t2im);
+            ++products;
+        }
+
+        // undo the shift by a: multiply by e^{−i a dt}
+        const double c = std::cos(h.centre * dt), s = std::sin(h.centre * dt);
+        for (int i = 0; i < cells; ++i)
+        {
+            const double r = re[i], m = im[i];
+            re[i] = r * c + m * s;
+            im[i] = m * c - r * s;
+        }
+    }
+    return products;
+}
+
+void ContinuousWalk::probability(std::vector<float>& out) const
+{
+    out.resize(re.size());
+    for (std::size_t i = 0; i < re.size(); ++i)
+        out[i] = static_cast<float>(re[i] * re[i] + im[i] * im[i]);
+}
+
+double ContinuousWalk::probabilityAt(int col, int row) const
+{
+    const int i = col + row * width;
+    return re[i] * re[i] + im[i] * im[i];
+}
@@ -0,0 +1,67 @@
+// =============================================================================
+// distanceField.cpp — Multi-source BFS distance field over the maze walls
+// =============================================================================
+
+#include "../include/distanceField.hpp"
+
+/* ------------------------------------------------------------------------- */
+/* update                                                                    */
+/* ------------------------------------------------------------------------- */
+bool DistanceField::update(const Grid& grid, int col, int row)
+{
+    if (valid && col == sourceCol && row == sourceRow &&
+        width == grid.width && height == grid.height)
+        return false;
+
+    compute(grid, { grid.index(col, row) });
+    sourceCol = col;
+    sourceRow = row;
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* compute                                                                   */
+/* ------------------------------------------------------------------------- */
+/** Plain BFS with a flat array queue: every cell is pushed at most once, so
+ *  the queue never needs more than width*height slots and no deque is used.
+ *  The flow table falls out of the same pass: the side a cell was reached
+ *  through, seen from the cell, leads back to its BFS parent.
+ */
+void DistanceField::compute(const Grid& grid, const std::vector<int>& sources)
+{
+    width  = grid.width;
+    height = grid.height;
+    const int cells = grid.cellCount();
+    dist.assign(cells, UNREACHABLE);
+    flow.assign(cells, -1);
+    queue.resize(cells);
+
+    int tail = 0;
+    for (int s : sources)
+    {
+        if (s < 0 || s >= cells || dist[s] == 0) continue;
+        dist[s] = 0;
+        queue[tail++] = s;
+    }
+
+    const int step[4] = { 1, width, -1, -width };  // RIGHT, DOWN, LEFT, TOP
+    for (int head = 0; head < tail; ++head)
+    {
+        const int cell = queue[head];
+        const int col  = cell % width;
+        const int row  = cell / width;
+        const std::uint32_t next = dist[cell] + 1;
+        for (int side = 0; side < 4; ++side)
+        {
+            if (grid.hasWall(col, row, side)) continue;
+            const int n = cell + step[side];
+            if (dist[n] != UNREACHABLE) continue;
+            dist[n] = next;
+            flow[n] = static_cast<std::int8_t>((side + 2) & 3);  // back the way it was found
+            queue[tail++] = n;
+        }
+    }
+
+    sourceCol = sourceRow = -1;      // a multi-source field matches no key
+    valid = true;
+}
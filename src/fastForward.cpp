@@ -0,0 +1,197 @@
+// =============================================================================
+// fastForward.cpp — k walk steps without k full sweeps
+// =============================================================================
+
+#include "../include/fastForward.hpp"
+#include <algorithm>           // std::fill, std::min
+#include <cmath>               // std::fabs
+
+/* ------------------------------------------------------------------------- */
+/* StationaryWalk                                                            */
+/* ------------------------------------------------------------------------- */
+/** Label components and colours with one BFS per component; the colour of
+ *  a cell is the parity of its BFS depth (the maze graph is bipartite).
+ */
+void StationaryWalk::update(const Grid& grid, const EvolveStencil& stencil)
+{
+    if (revision == grid.revision && static_cast<int>(classOf.size()) == grid.cellCount())
+        return;
+    revision = grid.revision;
+
+    const int cells     = grid.cellCount();
+    const int offset[4] = { 1, grid.width, -1, -grid.width };
+    classOf.assign(cells, -1);
+    weight.assign(cells, 0.0f);
+    classes = 0;
+
+    std::vector<int> queue(cells);
+    for (int seed = 0; seed < cells; ++seed)
+    {
+        if (classOf[seed] >= 0 || stencil.exits[seed] == 0) continue;   // done or sealed
+
+        const int component = classes / 2;
+        classes += 2;
+        int tail = 0;
+        queue[tail++] = seed;
+        classOf[seed] = 2 * component;
+        long long degreeSum = 0;
+        for (int head = 0; head < tail; ++head)
+        {
+            const int cell = queue[head];
+            const std::uint8_t e = stencil.exits[cell];
+            for (int side = 0; side < 4; ++side)
+            {
+                if (!((e >> side) & 1u)) continue;
+                ++degreeSum;
+                const int n = cell + offset[side];
+                if (classOf[n] >= 0) continue;
+                classOf[n] = classOf[cell] ^ 1;       // other colour
+                queue[tail++] = n;
+            }
+        }
+
+        const float edges = static_cast<float>(degreeSum / 2);   // = degree sum of one colour
+        for (int k = 0; k < tail; ++k)
+        {
+            const int cell = queue[k];
+            weight[cell] = (1.0f / stencil.invDegree[cell]) / edges;
+        }
+    }
+}
+
+void StationaryWalk::classMass(const float* field) const
+{
+    mass.assign(classes, 0.0);
+    for (std::size_t i = 0; i < classOf.size(); ++i)
+        if (classOf[i] >= 0) mass[classOf[i]] += field[i];
+}
+
+void StationaryWalk::project(const float* field, float* out, long long steps) const
+{
+    classMass(field);
+    const int flip = static_cast<int>(steps & 1);
+    for (std::size_t i = 0; i < classOf.size(); ++i)
+        out[i] = classOf[i] >= 0 ? static_cast<float>(mass[classOf[i] ^ flip] * weight[i]) : 0.0f;
+}
+
+float StationaryWalk::distance(const float* field) const
+{
+    classMass(field);
+    double d = 0.0;
+    for (std::size_t i = 0; i < classOf.size(); ++i)
+        d += std::fabs(field[i] - (classOf[i] >= 0 ? mass[classOf[i]] * weight[i] : 0.0));
+    return static_cast<float>(d);
+}
+
+/* ------------------------------------------------------------------------- */
+/* TransitionPowers                                                          */
+/* ------------------------------------------------------------------------- */
+void TransitionPowers::update(const Grid& grid, const EvolveStencil& stencil)
+{
+    if (revision == grid.revision && cells == grid.cellCount() && !powers.empty())
+        return;
+    revision = grid.revision;
+    cells    = grid.cellCount();
+
+    // P[i][n] = share of n's mass that moves to i in one step
+    const int offset[4] = { 1, grid.width, -1, -grid.width };
+    std::vector<float> p(static_cast<std::size_t>(cells) * cells, 0.0f);
+    for (int i = 0; i < cells; ++i)
+        for (int side = 0; side < 4; ++side)
+            if ((stencil.exits[i] >> side) & 1u)
+            {
+                const int n = i + offset[side];
+                p[static_cast<std::size_t>(i) * cells + n] = stencil.invDegree[n];
+            }
+    powers.clear();
+    powers.push_back(std::move(p));
+}
+
+void TransitionPowers::apply(std::vector<float>& field, std::vector<float>& spare, long long steps)
+{
+    const std::size_t n = cells;
+    spare.resize(field.size());
+    for (int j = 0; steps > 0; ++j, steps >>= 1)
+    {
+        if (j == static_cast<int>(powers.size()))
+        {
+            // P^(2^j) = (P^(2^(j-1)))^2, i-k-j order so the inner loop is a row sweep
+            const std::vector<float>& a = powers[j - 1];
+            std::vector<float> sq(n * n, 0.0f);
+            for (std::size_t r = 0; r < n; ++r)
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    const float x = a[r * n + k];
+                    if (x == 0.0f) continue;
+                    const float* row = &a[k * n];
+                    float*       dst = &sq[r * n];
+                    for (std::size_t c = 0; c < n; ++c) dst[c] += x * row[c];
+                }
+            powers.push_back(std::move(sq));
+        }
+        if (!(steps & 1)) continue;
+
+        const std::vector<float>& m = powers[j];
+        for (std::size_t r = 0; r < n; ++r)
+        {
+            const float* row = &m[r * n];
+            float acc = 0.0f;
+            for (std::size_t c = 0; c < n; ++c) acc += row[c] * field[c];
+            spare[r] = acc;
+        }
+        field.swap(spare);
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* fastForwardField                                                          */
+/* ------------------------------------------------------------------------- */
+void fastForwardField(const Grid& grid, std::vector<float>& field,
+                      std::vector<float>& spare, long long steps, ThreadPool* pool)
+{
+    if (steps <= 0) return;
+    const EvolveStencil& stencil = evolveStencil(grid);
+    const int cells = grid.cellCount();
+
+    if (cells <= QUANTUM_POWER_MAX_CELLS)
+    {
+        static TransitionPowers powers;
+        powers.update(grid, stencil);
+
+        // cost in multiply-adds: a small-grid step runs ~16x slower per cell
+        // than the vectorised squaring loop, a mat-vec ~4x slower
+        const double n = cells;
+        int bits = 0;
+        for (long long k = steps; k > 0; k >>= 1) ++bits;
+        const int    missing    = std::max(0, bits - static_cast<int>(powers.powers.size()));
+        const double powerCost  = missing * n * n * n + bits * 4.0 * n * n;
+        const double steppedCost = 16.0 * n * static_cast<double>(steps);
+        if (powerCost < steppedCost)
+        {
+            powers.apply(field, spare, steps);
+            return;
+        }
+    }
+
+    static StationaryWalk limit;
+    limit.update(grid, stencil);
+    float previous = QUANTUM_LIMIT_FLOOR;
+    while (steps > 0)
+    {
+        const int chunk = static_cast<int>(std::min<long long>(steps, QUANTUM_LIMIT_CHECK_STEPS));
+        evolveKernelSteps(stencil, field, spare, chunk, pool);
+        steps -= chunk;
+        if (steps == 0) break;
+
+        const float d = limit.distance(field.data());
+        const bool mixed = d < QUANTUM_LIMIT_EPSILON || (d < QUANTUM_LIMIT_FLOOR && d >= previous);
+        previous = d;
+        if (mixed)
+        {
+            spare.resize(field.size());
+            limit.project(field.data(), spare.data(), steps);
+            field.swap(spare);
+            return;
+        }
+    }
+}
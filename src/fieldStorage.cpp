@@ -0,0 +1,628 @@
+// =============================================================================
+// fieldStorage.cpp — Reduced-precision probability fields
+//
+// Half kernels mirror the float gather kernels of quantumKernels.cpp: the
+// four neighbour contributions are added in RIGHT, DOWN, LEFT, TOP order,
+// SIMD lanes cover [width, cells - width) and the first and last rows go
+// through the scalar path.  The AVX-512 kernel looks 1/degree up from the
+// neighbour's exit mask instead of loading invDegree, so a step streams
+// 2 + 2 bytes of field and 1 byte of exits per cell.
+// =============================================================================
+
+#include "../include/fieldStorage.hpp"
+#include <algorithm>           // std::max, std::min, std::clamp, std::fill
+#include <cmath>               // std::lround
+#include <cstring>             // std::memcpy
+
+#if defined(__GNUC__) && !defined(__clang__)
+// keep SIMD mul + add unfused so every kernel rounds like the scalar one
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIELD_KERNELS_X86 1
+#include <immintrin.h>         // AVX2 / F16C / AVX-512 intrinsics
+#endif
+
+bool parseFieldPrecision(const std::string& name, FieldPrecision& out)
+{
+    if (name == "float32")  { out = FieldPrecision::Float32;  return true; }
+    if (name == "float16")  { out = FieldPrecision::Float16;  return true; }
+    if (name == "bfloat16") { out = FieldPrecision::BFloat16; return true; }
+    if (name == "fixed32")  { out = FieldPrecision::Fixed32;  return true; }
+    return false;
+}
+
+const char* fieldPrecisionName(FieldPrecision precision)
+{
+    switch (precision)
+    {
+        case FieldPrecision::Float32:  return "float32";
+        case FieldPrecision::Float16:  return "float16";
+        case FieldPrecision::BFloat16: return "bfloat16";
+        case FieldPrecision::Fixed32:  return "fixed32";
+    }
+    return "?";
+}
+
+/* ------------------------------------------------------------------------- */
+/* scalar conversions                                                        */
+/* ------------------------------------------------------------------------- */
+static inline std::uint32_t floatBits(float f)        { std::uint32_t u; std::memcpy(&u, &f, 4); return u; }
+static inline float         bitsFloat(std::uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+/** IEEE binary16 → float (exact) */
+static inline float halfToFloat(std::uint16_t h)
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    const std::uint32_t exp  = (h >> 10) & 0x1Fu;
+    const std::uint32_t man  = h & 0x3FFu;
+    if (exp == 0)                                     // zero / subnormal: man · 2^-24
+        return bitsFloat(sign | floatBits(static_cast<float>(man) * (1.0f / 16777216.0f)));
+    if (exp == 31)
+        return bitsFloat(sign | 0x7F800000u | (man << 13));
+    return bitsFloat(sign | ((exp + 112) << 23) | (man << 13));
+}
+
+/** float → IEEE binary16, round to nearest even, overflow to infinity */
+static inline std::uint16_t floatToHalf(float f)
+{
+    const std::uint32_t x    = floatBits(f);
+    const std::uint16_t sign = static_cast<std::uint16_t>((x >> 16) & 0x8000u);
+    const std::uint32_t absx = x & 0x7FFFFFFFu;
+    if (absx >= 0x7F800000u)                          // inf / nan
+        return sign | 0x7C00u | (absx > 0x7F800000u ? 0x200u : 0u);
+    if (absx >= 0x477FF000u)                          // rounds past 65504
+        return sign | 0x7C00u;
+    if (absx < 0x38800000u)                           // below the smallest normal half
+    {
+        // the FPU rounds to nearest even at 2^-24 granularity for us
+        const float scaled = bitsFloat(absx) * 16777216.0f;
+        return sign | static_cast<std::uint16_t>(std::nearbyint(scaled));
+    }
+    const std::uint32_t rounded = absx + 0xFFFu + ((absx >> 13) & 1u);
+    return sign | static_cast<std::uint16_t>((rounded - (112u << 23)) >> 13);
+}
+
+static inline float bf16ToFloat(std::uint16_t h) { return bitsFloat(static_cast<std::uint32_t>(h) << 16); }
+
+static inline std::uint16_t floatToBf16(float f)
+{
+    const std::uint32_t x = floatBits(f);
+    return static_cast<std::uint16_t>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+}
+
+static inline std::uint32_t floatToFixed(float f)
+{
+    if (!(f > 0.0f)) return 0;
+    if (f >= 1.0f)   return FIELD_FIXED_ONE;
+    return static_cast<std::uint32_t>(std::nearbyint(f * 2147483648.0f));
+}
+
+static inline float fixedToFloat(std::uint32_t v) { return static_cast<float>(v) * (1.0f / 2147483648.0f); }
+
+/** Packs in[0, n) into half[0, n) / fixed[0, n) (only the plane of @p p is used) */
+static void packScalar(const float* in, int begin, int end, FieldPrecision p,
+                       std::uint16_t* half, std::uint32_t* fixed)
+{
+    for (int i = begin; i < end; ++i)
+        switch (p)
+        {
+            case FieldPrecision::Float16:  half[i]  = floatToHalf(in[i] * FIELD_HALF_SCALE); break;
+            case FieldPrecision::BFloat16: half[i]  = floatToBf16(in[i]); break;
+            case FieldPrecision::Fixed32:  fixed[i] = floatToFixed(in[i]); break;
+            case FieldPrecision::Float32:  break;
+        }
+}
+
+static inline float unpackOne(FieldPrecision p, const std::uint16_t* half, const std::uint32_t* fixed, int i)
+{
+    switch (p)
+    {
+        case FieldPrecision::Float16:  return halfToFloat(half[i]) * (1.0f / FIELD_HALF_SCALE);
+        case FieldPrecision::BFloat16: return bf16ToFloat(half[i]);
+        case FieldPrecision::Fixed32:  return fixedToFloat(fixed[i]);
+        case FieldPrecision::Float32:  break;
+    }
+    return 0.0f;
+}
+
+static void unpackScalar(FieldPrecision p, const std::uint16_t* half, const std::uint32_t* fixed,
+                         int begin, int end, float* out)
+{
+    for (int i = begin; i < end; ++i)
+        out[i] = unpackOne(p, half, fixed, i);
+}
+
+#ifdef FIELD_KERNELS_X86
+/* ------------------------------------------------------------------------- */
+/* SIMD conversions                                                          */
+/* ------------------------------------------------------------------------- */
+__attribute__((target("avx512f")))
+static inline __m512 loadHalf16(const std::uint16_t* p, bool bf16)
+{
+    const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return bf16 ? _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16))
+                : _mm512_cvtph_ps(h);
+}
+
+__attribute__((target("avx512f")))
+static inline void storeHalf16(std::uint16_t* p, __m512 v, bool bf16)
+{
+    __m256i h;
+    if (bf16)
+    {
+        const __m512i x   = _mm512_castps_si512(v);
+        const __m512i odd = _mm512_and_si512(_mm512_srli_epi32(x, 16), _mm512_set1_epi32(1));
+        h = _mm512_cvtepi32_epi16(_mm512_srli_epi32(
+                _mm512_add_epi32(x, _mm512_add_epi32(odd, _mm512_set1_epi32(0x7FFF))), 16));
+    }
+    else
+        h = _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), h);
+}
+
+__attribute__((target("avx2,f16c")))
+static inline __m256 loadHalf8(const std::uint16_t* p, bool bf16)
+{
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return bf16 ? _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16))
+                : _mm256_cvtph_ps(h);
+}
+
+__attribute__((target("avx2,f16c")))
+static inline void storeHalf8(std::uint16_t* p, __m256 v, bool bf16)
+{
+    __m128i h;
+    if (bf16)
+    {
+        const __m256i x   = _mm256_castps_si256(v);
+        const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+        const __m256i r   = _mm256_srli_epi32(
+            _mm256_add_epi32(x, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF))), 16);
+        h = _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+    }
+    else
+        h = _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), h);
+}
+
+/** Float16 / BFloat16 / Fixed32 pack, 16 cells per iteration */
+__attribute__((target("avx512f")))
+static void packAvx512(const float* in, int n, FieldPrecision p, std::uint16_t* half, std::uint32_t* fixed)
+{
+    const bool   bf16  = p == FieldPrecision::BFloat16;
+    const __m512 scale = _mm512_set1_ps(p == FieldPrecision::Float16 ? FIELD_HALF_SCALE : 2147483648.0f);
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512 v = _mm512_loadu_ps(in + i);
+        if (p == FieldPrecision::Fixed32)
+        {
+            // p·2^31 is exact; 1.0 overflows to 0x80000000 = FIELD_FIXED_ONE
+            const __m512 c = _mm512_max_ps(_mm512_mul_ps(v, scale), _mm512_setzero_ps());
+            _mm512_storeu_si512(fixed + i, _mm512_cvtps_epi32(c));
+        }
+        else
+            storeHalf16(half + i, bf16 ? v : _mm512_mul_ps(v, scale), bf16);
+    }
+    packScalar(in, i, n, p, half, fixed);
+}
+
+__attribute__((target("avx512f")))
+static void unpackAvx512(FieldPrecision p, const std::uint16_t* half, const std::uint32_t* fixed,
+                         int n, float* out)
+{
+    const bool bf16 = p == FieldPrecision::BFloat16;
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512 v;
+        if (p == FieldPrecision::Fixed32)
+            v = _mm512_mul_ps(_mm512_cvtepu32_ps(_mm512_loadu_si512(fixed + i)),
+                              _mm512_set1_ps(1.0f / 2147483648.0f));
+        else
+        {
+            v = loadHalf16(half + i, bf16);
+            if (!bf16) v = _mm512_mul_ps(v, _mm512_set1_ps(1.0f / FIELD_HALF_SCALE));
+        }
+        _mm512_storeu_ps(out + i, v);
+    }
+    unpackScalar(p, half, fixed, i, n, out);
+}
+
+/** Half formats only (Fixed32 packs through the scalar path on AVX2) */
+__attribute__((target("avx2,f16c")))
+static void packAvx2(const float* in, int n, FieldPrecision p, std::uint16_t* half, std::uint32_t* fixed)
+{
+    if (p == FieldPrecision::Fixed32) { packScalar(in, 0, n, p, half, fixed); return; }
+    const bool   bf16  = p == FieldPrecision::BFloat16;
+    const __m256 scale = _mm256_set1_ps(FIELD_HALF_SCALE);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(in + i);
+        storeHalf8(half + i, bf16 ? v : _mm256_mul_ps(v, scale), bf16);
+    }
+    packScalar(in, i, n, p, half, fixed);
+}
+
+__attribute__((target("avx2,f16c")))
+static void unpackAvx2(FieldPrecision p, const std::uint16_t* half, const std::uint32_t* fixed,
+                       int n, float* out)
+{
+    if (p == FieldPrecision::Fixed32) { unpackScalar(p, half, fixed, 0, n, out); return; }
+    const bool bf16 = p == FieldPrecision::BFloat16;
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 v = loadHalf8(half + i, bf16);
+        if (!bf16) v = _mm256_mul_ps(v, _mm256_set1_ps(1.0f / FIELD_HALF_SCALE));
+        _mm256_storeu_ps(out + i, v);
+    }
+    unpackScalar(p, half, fixed, i, n, out);
+}
+#endif // FIELD_KERNELS_X86
+
+/* ------------------------------------------------------------------------- */
+/* half-precision step                                                       */
+/* ------------------------------------------------------------------------- */
+static inline float loadHalf(std::uint16_t h, bool bf16) { return bf16 ? bf16ToFloat(h) : halfToFloat(h); }
+static inline std::uint16_t storeHalf(float f, bool bf16) { return bf16 ? floatToBf16(f) : floatToHalf(f); }
+
+static void evolveHalfScalar(const EvolveStencil& s, const std::uint16_t* in, std::uint16_t* out,
+                             bool bf16, int begin, int end)
+{
+    const int    w = s.width;
+    const float* inv = s.invDegree.data();
+    for (int i = begin; i < end; ++i)
+    {
+        const std::uint8_t e = s.exits[i];
+        float acc = 0.0f;
+        if (e & 1u) acc += loadHalf(in[i + 1], bf16) * inv[i + 1];
+        if (e & 2u) acc += loadHalf(in[i + w], bf16) * inv[i + w];
+        if (e & 4u) acc += loadHalf(in[i - 1], bf16) * inv[i - 1];
+        if (e & 8u) acc += loadHalf(in[i - w], bf16) * inv[i - w];
+        out[i] = storeHalf(acc, bf16);
+    }
+}
+
+#ifdef FIELD_KERNELS_X86
+__attribute__((target("avx2,f16c")))
+static void evolveHalfAvx2(const EvolveStencil& s, const std::uint16_t* in, std::uint16_t* out,
+                           bool bf16, int begin, int end)
+{
+    const int w = s.width;
+    const int vBegin = std::max(begin, w);
+    const int vEnd   = std::min(end, w * s.height - w);
+    if (vBegin >= vEnd) { evolveHalfScalar(s, in, out, bf16, begin, end); return; }
+
+    const float*        inv = s.invDegree.data();
+    const std::uint8_t* ex  = s.exits.data();
+    const int           offset[4] = { 1, w, -1, -w };
+
+    evolveHalfScalar(s, in, out, bf16, begin, vBegin);
+    int i = vBegin;
+    for (; i + 8 <= vEnd; i += 8)
+    {
+        const __m256i e = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ex + i)));
+        __m256 acc = _mm256_setzero_ps();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __m256i bit  = _mm256_set1_epi32(1 << side);
+            const __m256  open = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(e, bit), bit));
+            const int     n    = i + offset[side];
+            const __m256  q    = _mm256_mul_ps(loadHalf8(in + n, bf16), _mm256_loadu_ps(inv + n));
+            acc = _mm256_add_ps(acc, _mm256_and_ps(open, q));
+        }
+        storeHalf8(out + i, acc, bf16);
+    }
+    evolveHalfScalar(s, in, out, bf16, i, end);
+}
+
+__attribute__((target("avx512f")))
+static void evolveHalfAvx512(const EvolveStencil& s, const std::uint16_t* in, std::uint16_t* out,
+                             bool bf16, int begin, int end)
+{
+    const int w = s.width;
+    const int vBegin = std::max(begin, w);
+    const int vEnd   = std::min(end, w * s.height - w);
+    if (vBegin >= vEnd) { evolveHalfScalar(s, in, out, bf16, begin, end); return; }
+
+    // 1/degree by exit mask: the same floats EvolveStencil::update stores
+    alignas(64) float invTable[16];
+    for (int m = 0; m < 16; ++m)
+    {
+        const int count = (m & 1) + ((m >> 1) & 1) + ((m >> 2) & 1) + ((m >> 3) & 1);
+        invTable[m] = count ? 1.0f / static_cast<float>(count) : 0.0f;
+    }
+    const __m512        table = _mm512_load_ps(invTable);
+    const std::uint8_t* ex    = s.exits.data();
+    const int           offset[4] = { 1, w, -1, -w };
+
+    evolveHalfScalar(s, in, out, bf16, begin, vBegin);
+    int i = vBegin;
+    for (; i + 16 <= vEnd; i += 16)
+    {
+        const __m512i e = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ex + i)));
+        __m512 acc = _mm512_setzero_ps();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __mmask16 open = _mm512_test_epi32_mask(e, _mm512_set1_epi32(1 << side));
+            const int       n    = i + offset[side];
+            const __m512i   en   = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ex + n)));
+            const __m512    q    = _mm512_mul_ps(loadHalf16(in + n, bf16), _mm512_permutexvar_ps(en, table));
+            acc = _mm512_mask_add_ps(acc, open, acc, q);
+        }
+        storeHalf16(out + i, acc, bf16);
+    }
+    evolveHalfScalar(s, in, out, bf16, i, end);
+}
+#endif // FIELD_KERNELS_X86
+
+/* ------------------------------------------------------------------------- */
+/* fixed-point step                                                          */
+/* ------------------------------------------------------------------------- */
+/** Share of @p v (≤ FIELD_FIXED_ONE) that a cell with exit mask @p e sends
+ *  through @p side: v / k, plus one unit of the remainder for each of the
+ *  first (v mod k) open sides in RIGHT, DOWN, LEFT, TOP order.  The k
+ *  shares sum to v exactly.  The division is a multiply and a shift:
+ *  (v · ceil(2^33/3)) >> 33 is exactly v / 3 for every 32-bit v.
+ */
+static inline std::uint32_t fixedShare(std::uint32_t v, std::uint8_t e, int side)
+{
+    static const std::uint64_t magic[5] = { 0, 1, 1, 0xAAAAAAABull, 1 };
+    static const std::uint8_t  shift[5] = { 0, 0, 1, 33, 2 };
+    static const std::uint8_t  degree[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+    const std::uint32_t k    = degree[e];
+    const std::uint32_t q    = static_cast<std::uint32_t>((v * magic[k]) >> shift[k]);
+    const std::uint32_t rem  = v - q * k;
+    const std::uint32_t rank = degree[e & ((1u << side) - 1u)];
+    return q + (rank < rem ? 1u : 0u);
+}
+
+static void evolveFixed(const EvolveStencil& s, const std::uint32_t* in, std::uint32_t* out,
+                        int begin, int end)
+{
+    const int w = s.width;
+    const std::uint8_t* ex = s.exits.data();
+    for (int i = begin; i < end; ++i)
+    {
+        const std::uint8_t e = ex[i];
+        std::uint32_t acc = 0;                       // side s of i is side s^2 of the neighbour
+        if (e & 1u) acc += fixedShare(in[i + 1], ex[i + 1], 2);
+        if (e & 2u) acc += fixedShare(in[i + w], ex[i + w], 3);
+        if (e & 4u) acc += fixedShare(in[i - 1], ex[i - 1], 0);
+        if (e & 8u) acc += fixedShare(in[i - w], ex[i - w], 1);
+        out[i] = e ? acc : in[i];                    // a sealed cell keeps its mass
+    }
+}
+
+#ifdef FIELD_KERNELS_X86
+/** fixedShare for 16 neighbours at once; @p toward is the side facing the
+ *  gathering cell */
+__attribute__((target("avx512f")))
+static inline __m512i fixedShare16(__m512i v, __m512i e, int toward)
+{
+    const __m512i degree = _mm512_setr_epi32(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m512i k      = _mm512_permutexvar_epi32(e, degree);
+
+    // k = 1, 2, 4: a shift by 0, 1, 2
+    __m512i q = _mm512_srlv_epi32(v, _mm512_srli_epi32(k, 1));
+
+    // k = 3: (v · 0xAAAAAAAB) >> 33, even and odd lanes as 64-bit products
+    const __mmask16 three = _mm512_cmpeq_epi32_mask(k, _mm512_set1_epi32(3));
+    if (three)
+    {
+        const __m512i magic = _mm512_set1_epi64(0xAAAAAAABll);
+        const __m512i even  = _mm512_srli_epi64(_mm512_mul_epu32(v, magic), 33);
+        const __m512i odd   = _mm512_srli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(v, 32), magic), 1);
+        const __m512i q3    = _mm512_mask_blend_epi32(0xAAAA, even, odd);
+        q = _mm512_mask_mov_epi32(q, three, q3);
+    }
+
+    const __m512i rem  = _mm512_sub_epi32(v, _mm512_mullo_epi32(q, k));
+    const __m512i rank = _mm512_permutexvar_epi32(
+        _mm512_and_si512(e, _mm512_set1_epi32((1 << toward) - 1)), degree);
+    return _mm512_mask_add_epi32(q, _mm512_cmplt_epu32_mask(rank, rem), q, _mm512_set1_epi32(1));
+}
+
+__attribute__((target("avx512f")))
+static void evolveFixedAvx512(const EvolveStencil& s, const std::uint32_t* in, std::uint32_t* out)
+{
+    const int w = s.width;
+    const int cells = w * s.height;
+    if (s.height < 3) { evolveFixed(s, in, out, 0, cells); return; }
+
+    const std::uint8_t* ex = s.exits.data();
+    const int           offset[4] = { 1, w, -1, -w };
+
+    evolveFixed(s, in, out, 0, w);
+    int i = w;
+    for (; i + 16 <= cells - w; i += 16)
+    {
+        const __m512i e   = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ex + i)));
+        __m512i       acc = _mm512_setzero_si512();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __mmask16 open = _mm512_test_epi32_mask(e, _mm512_set1_epi32(1 << side));
+            if (!open) continue;
+            const int     n  = i + offset[side];
+            const __m512i en = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ex + n)));
+            const __m512i v  = _mm512_loadu_si512(in + n);
+            acc = _mm512_mask_add_epi32(acc, open, acc, fixedShare16(v, en, side ^ 2));
+        }
+        // a sealed cell keeps its mass
+        const __mmask16 sealed = _mm512_cmpeq_epi32_mask(e, _mm512_setzero_si512());
+        acc = _mm512_mask_loadu_epi32(acc, sealed, in + i);
+        _mm512_storeu_si512(out + i, acc);
+    }
+    evolveFixed(s, in, out, i, cells);
+}
+#endif // FIELD_KERNELS_X86
+
+/* ------------------------------------------------------------------------- */
+/* dispatch                                                                  */
+/* ------------------------------------------------------------------------- */
+struct FieldDispatch {
+    void (*pack)(const float*, int, FieldPrecision, std::uint16_t*, std::uint32_t*);
+    void (*unpack)(FieldPrecision, const std::uint16_t*, const std::uint32_t*, int, float*);
+    void (*half)(const EvolveStencil&, const std::uint16_t*, std::uint16_t*, bool, int, int);
+    void (*fixed)(const EvolveStencil&, const std::uint32_t*, std::uint32_t*);
+};
+
+static void packPortable(const float* in, int n, FieldPrecision p, std::uint16_t* half, std::uint32_t* fixed)
+{
+    packScalar(in, 0, n, p, half, fixed);
+}
+static void unpackPortable(FieldPrecision p, const std::uint16_t* half, const std::uint32_t* fixed,
+                           int n, float* out)
+{
+    unpackScalar(p, half, fixed, 0, n, out);
+}
+static void evolveFixedPortable(const EvolveStencil& s, const std::uint32_t* in, std::uint32_t* out)
+{
+    evolveFixed(s, in, out, 0, s.width * s.height);
+}
+
+static const FieldDispatch& fieldDispatch()
+{
+    static const FieldDispatch chosen = []() -> FieldDispatch {
+#ifdef FIELD_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return { packAvx512, unpackAvx512, evolveHalfAvx512, evolveFixedAvx512 };
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c"))
+            return { packAvx2, unpackAvx2, evolveHalfAvx2, evolveFixedPortable };
+#endif
+        return { packPortable, unpackPortable, evolveHalfScalar, evolveFixedPortable };
+    }();
+    return chosen;
+}
+
+/* ------------------------------------------------------------------------- */
+/* PackedField                                                               */
+/* ------------------------------------------------------------------------- */
+/** Cells converted per pass by the chunked helpers (16 KiB of floats) */
+static constexpr int FIELD_CHUNK_CELLS = 4096;
+
+void PackedField::allocate(int n, FieldPrecision p)
+{
+    precision = p;
+    cells     = n;
+    const bool isFixed = p == FieldPrecision::Fixed32;
+    half.resize(isFixed || p == FieldPrecision::Float32 ? 0 : n);
+    fixed.resize(isFixed ? n : 0);
+}
+
+void PackedField::pack(const float* in, int n, FieldPrecision p)
+{
+    allocate(n, p);
+    packRange(in, 0, n);
+}
+
+void PackedField::packRange(const float* in, int begin, int end)
+{
+    if (precision == FieldPrecision::Float32 || end <= begin) return;
+    fieldDispatch().pack(in, end - begin, precision,
+                         half.empty()  ? nullptr : half.data()  + begin,
+                         fixed.empty() ? nullptr : fixed.data() + begin);
+}
+
+void PackedField::unpack(float* out) const
+{
+    unpack(out, 0, cells);
+}
+
+void PackedField::unpack(float* out, int begin, int end) const
+{
+    if (precision == FieldPrecision::Float32 || end <= begin) return;
+    fieldDispatch().unpack(precision,
+                           half.empty()  ? nullptr : half.data()  + begin,
+                           fixed.empty() ? nullptr : fixed.data() + begin,
+                           end - begin, out);
+}
+
+float PackedField::at(int cell) const
+{
+    return unpackOne(precision, half.data(), fixed.data(), cell);
+}
+
+void PackedField::set(int cell, float value)
+{
+    switch (precision)
+    {
+        case FieldPrecision::Float16:  half[cell]  = floatToHalf(value * FIELD_HALF_SCALE); break;
+        case FieldPrecision::BFloat16: half[cell]  = floatToBf16(value); break;
+        case FieldPrecision::Fixed32:  fixed[cell] = floatToFixed(value); break;
+        case FieldPrecision::Float32:  break;
+    }
+}
+
+void PackedField::fill(int n, FieldPrecision p, float value)
+{
+    allocate(n, p);
+    if (n == 0) return;
+    set(0, value);                           // encode once, copy the bits
+    if (!half.empty())  std::fill(half.begin() + 1, half.end(), half[0]);
+    if (!fixed.empty()) std::fill(fixed.begin() + 1, fixed.end(), fixed[0]);
+}
+
+void PackedField::resizeLike(const PackedField& other)
+{
+    precision = other.precision;
+    cells     = other.cells;
+    half.resize(other.half.size());
+    fixed.resize(other.fixed.size());
+}
+
+void PackedField::shiftDown(int n)
+{
+    n = std::clamp(n, 0, cells);
+    if (!half.empty())
+    {
+        std::copy(half.begin() + n, half.end(), half.begin());
+        std::fill(half.end() - n, half.end(), std::uint16_t(0));
+    }
+    if (!fixed.empty())
+    {
+        std::copy(fixed.begin() + n, fixed.end(), fixed.begin());
+        std::fill(fixed.end() - n, fixed.end(), 0u);
+    }
+}
+
+double PackedField::sum() const
+{
+    float  chunk[FIELD_CHUNK_CELLS];
+    double total = 0.0;
+    for (int b = 0; b < cells; b += FIELD_CHUNK_CELLS)
+    {
+        const int e = std::min(cells, b + FIELD_CHUNK_CELLS);
+        unpack(chunk, b, e);
+        for (int i = 0; i < e - b; ++i) total += chunk[i];
+    }
+    return total;
+}
+
+void PackedField::scale(float factor)
+{
+    float chunk[FIELD_CHUNK_CELLS];
+    for (int b = 0; b < cells; b += FIELD_CHUNK_CELLS)
+    {
+        const int e = std::min(cells, b + FIELD_CHUNK_CELLS);
+        unpack(chunk, b, e);
+        for (int i = 0; i < e - b; ++i) chunk[i] *= factor;
+        packRange(chunk, b, e);
+    }
+}
+
+void evolvePacked(const EvolveStencil& stencil, const PackedField& in, PackedField& out)
+{
+    out.resizeLike(in);
+    const int cells = stencil.width * stencil.height;
+    if (in.precision == FieldPrecision::Fixed32)
+        fieldDispatch().fixed(stencil, in.fixed.data(), out.fixed.data());
+    else if (in.precision != FieldPrecision::Float32)
+        fieldDispatch().half(stencil, in.half.data(), out.half.data(),
+                             in.precision == FieldPrecision::BFloat16, 0, cells);
+}
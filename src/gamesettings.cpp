@@ -1,6 +1,7 @@
 #include "../include/mazeHelper.hpp"
 #include "../include/particle.hpp"   // ClassicalParticle, QuantumParticle
 #include "../include/gamesettings.hpp" // Game settings header
+#include "../include/rng.hpp" // Rng streams
 #include <SFML/Graphics.hpp> // For graphics rendering
 
 
@@ -10,19 +11,21 @@
 
 //another function to imporve the bots the way they are generated
 //genereted the bots in a random way and with a defined number of bots
-void generateBots(std::vector<ClassicalParticle*>& bots, int numBots, Node* nodeList) {
-    for (int i = 0; i < numBots; ++i) {
-        ClassicalParticle* bot = new ClassicalParticle; //creating the bot 
+void generateBots(BotSystem& bots, int numBots, const Grid& grid) {
+    Rng rng = makeRng(RNG_STREAM_BOTS, bots.size()); // reproducible from the master seed
+    bots.reserve(bots.size() + numBots);             // one allocation for the whole batch
+    for (int n = 0; n < numBots; ++n) {
         // bot->position = sf::Vector2f(0.f, 0.f); // Initial position
-        bot->position= sf::Vector2f(std::rand() % GRID_HEIGHT,  std::rand() % GRID_WIDTH); // Initial position
+        const std::size_t i = bots.add(sf::Vector2f(rng.below(grid.height),  rng.below(grid.width)), 0, 0, sf::Color::Green); // Initial position
         // bot->velocity = sf::Vector2f(10.f, 5.f); // Initial velocity
-        bot->velocity = sf::Vector2f(std::rand() % 10 , std::rand() % 10); // Initial velocity
-        bot->acceleration = sf::Vector2f(std::rand() % 100, std::rand() % 100); // Initial acceleration
-        bot->col = std::rand() % GRID_WIDTH; // Random column
-        bot->row = std::rand() % GRID_HEIGHT; // Random row
-        bot->color = sf::Color(std::rand() , std::rand() , std::rand()); // Default color
-        bot->setPosition(bot->col, bot->row, nodeList); // Set position in the maze
-        bots.push_back(bot);
+        const sf::Vector2f velocity(rng.below(10) , rng.below(10)); // Initial velocity
+        const sf::Vector2f acceleration(rng.below(100), rng.below(100)); // Initial acceleration
+        bots.vx[i] = velocity.x;     bots.vy[i] = velocity.y;
+        bots.ax[i] = acceleration.x; bots.ay[i] = acceleration.y;
+        bots.col[i] = rng.below(grid.width); // Random column
+        bots.row[i] = rng.below(grid.height); // Random row
+        bots.color[i] = sf::Color(rng() , rng() , rng()); // Default color
+        bots.setPosition(i, bots.col[i], bots.row[i], grid); // Set position in the maze
         
     }
     std::cout << "Bots generated "<<numBots << "!\n";
@@ -33,15 +36,15 @@ void generateBots(std::vector<ClassicalParticle*>& bots, int numBots, Node* node
 
 
 //just a function to reset the gaame 
-void resetGame(Node* nodeList, std::vector<Wall>& wallVec, PlayerParticle& player,
-                std::vector<ClassicalParticle*>& bots, bool& mazeReady, int& cur_col, int& cur_row) {
+void resetGame(Grid& grid, MazeGenerator& generator, PlayerParticle& player,
+                BotSystem& bots, bool& mazeReady, int& cur_col, int& cur_row,
+                MazeStream* stream, DistanceField* finishField) {
         // Reset maze
-        std::fill(nodeList, nodeList + (GRID_WIDTH * GRID_HEIGHT), Node{}); // Clear all nodes
-        wallVec.clear();          // Clear walls
-        cur_col = std::rand() % GRID_WIDTH; // Random starting cell
-        cur_row = std::rand() % GRID_HEIGHT;
-        nodeList[cur_col + cur_row * GRID_WIDTH].visited = true;
-        addWalls(wallVec, nodeList, cur_col, cur_row);
+        Rng& rng = threadRng();
+        cur_col = rng.below(grid.width); // Random starting cell
+        cur_row = rng.below(grid.height);
+        if (stream) stream->begin(grid);             // Endless mode: fresh stream
+        else generator.generate(grid, cur_col, cur_row); // Clears and re-carves every node
         mazeReady = false;
 
         // Reset player
@@ -51,16 +54,17 @@ void resetGame(Node* nodeList, std::vector<Wall>& wallVec, PlayerParticle& playe
         player.row = 0;
 
         // Reset bots
-        for (auto& bot : bots) {
-        bot->position = sf::Vector2f(0.f, 0.f);
-        bot->velocity = sf::Vector2f(10.f, 5.f);
-        bot->col = 0;
-        bot->row = 0;
+        for (std::size_t i = 0; i < bots.size(); ++i) {
+        bots.x[i] = 0.f;   bots.y[i] = 0.f;
+        bots.vx[i] = 10.f; bots.vy[i] = 5.f;
+        bots.col[i] = 0;
+        bots.row[i] = 0;
         }
 
         // Reset finish line
-        FINISH_COL = std::rand() % GRID_WIDTH;
-        FINISH_ROW = std::rand() % GRID_HEIGHT;
+        FINISH_COL = rng.below(grid.width);
+        FINISH_ROW = rng.below(grid.height);
+        if (finishField) finishField->invalidate();  // new walls, new distances
 
         std::cout << "Game reset!\n";
 }
@@ -6,6 +6,39 @@
 // classical particle obeys Newtonian kinematics, while the quantum particle
 // performs a discrete quantum walk and can be collapsed with the SPACE key.
 //
+// Usage:
+//   labirinto_quantico [width] [height] [--seed S] [--algo NAME] [--threads N] [--numa]
+//                      [--bench-gen] [--stream] [--save FILE] [--load FILE]
+//                      [--coin NAME] [--ctqw T] [--precision NAME]
+//                      [--tick-rate HZ] [--headless TICKS] [--navigate]
+//     width height — maze size in cells (default 30x30)
+//     --seed S     — master seed; the same seed replays the same run
+//                    (default: the clock, printed at startup)
+//     --algo NAME  — prim (default), kruskal, wilson, backtracker, eller
+//     --threads N  — carve big mazes in parallel tiles on N threads and
+//                    split the quantum walk's steps into N row bands
+//     --numa       — with --threads: first-touch the walk's field so each
+//                    band's pages sit on the node of the thread evolving it
+//     --bench-gen  — time every generator on the grid and exit (no window)
+//     --stream     — endless maze: the view scrolls up one row every
+//                    STREAM_SCROLL_SECONDS, memory stays constant
+//     --save FILE  — write the generated maze (walls, seed, start, finish)
+//     --load FILE  — play a saved maze instead of generating one; its size
+//                    and, unless --seed is given, its seed are reused
+//     --coin NAME  — grover or fourier: the quantum particle runs a coined
+//                    walk with complex amplitudes from the start cell
+//     --ctqw T     — propagate a continuous-time quantum walk from the start
+//                    cell to time T and report its probability at the finish
+//     --precision NAME — float32 (default), float16, bfloat16 or fixed32:
+//                    storage the quantum particle's field is stepped and
+//                    kept in
+//     --tick-rate HZ — fixed simulation rate (default SIM_DEFAULT_TICK_RATE);
+//                    frames only decide how often the world is drawn
+//     --headless TICKS — run TICKS simulation ticks without a window,
+//                    as fast as possible, and print the final state
+//     --navigate   — bots race for the finish along a shared flow field
+//                    instead of drifting
+//
 // Keyboard controls:
 //   • SPACE  — collapse the quantum particle’s probability field
 //   • window close button / Alt+F4 — exit
@@ -18,6 +51,7 @@
 
 #include <iostream>
 #include <filesystem>
+#include <string>
 #include <vector>
 #include <cmath>
 #include <cstdlib>
@@ -26,7 +60,15 @@
 #include <time.h>
 #include <random>                 // add this
 #include <algorithm>            // add this for shuffle/remove_if/min
-#include "../include/mazeHelper.hpp"              // grid constants, Node, drawMaze()
+#include "../include/mazeHelper.hpp"              // Grid, Node, drawMaze()
+#include "../include/mazeGenerator.hpp"           // MazeGenerator, MazeAlgorithm
+#include "../include/mazeStream.hpp"              // MazeStream (endless mode)
+#include "../include/rng.hpp"                     // master seed, Rng streams
+#include "../include/mazeFile.hpp"                // .qmaze save / mmap load
+#include "../include/distanceField.hpp"           // BFS distance to the finish
+#include "../include/quantumEnsemble.hpp"         // batched quantum walkers
+#include "../include/continuousWalk.hpp"          // --ctqw transport runs
+#include "../include/simulation.hpp"              // fixed-timestep world
 #include <SFML/Graphics.hpp>
 #include "../include/particle.hpp"   // ClassicalParticle, QuantumParticle
 #include <SFML/Audio.hpp>  //audio
@@ -42,15 +84,112 @@
  *
  * @return `int` — exit status (0 = success).
  */
-int main()
+int main(int argc, char* argv[])
 {
+    // ---------------------------------------------------------------------
+    // Grid size (runtime, heap backed)
+    // ---------------------------------------------------------------------
+    int gridWidth  = DEFAULT_GRID_WIDTH;
+    int gridHeight = DEFAULT_GRID_HEIGHT;
+    int positional = 0;
+    bool benchGen  = false;
+    bool streamMode = false;
+    std::uint64_t seed = static_cast<std::uint64_t>(std::time(nullptr));
+    bool seedGiven = false;
+    std::string savePath, loadPath;
+    bool coherent = false;
+    bool numa = false;
+    double ctqwTime = 0.0;
+    QuantumCoin coin = QuantumCoin::Grover;
+    FieldPrecision precision = FieldPrecision::Float32;
+    double tickRate = SIM_DEFAULT_TICK_RATE;
+    long long headlessTicks = 0;
+    bool navigate = false;
+    MazeGenerator generator;
+    MazeStream    stream;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--algo" && i + 1 < argc) {
+            if (!parseMazeAlgorithm(argv[++i], generator.algorithm))
+                std::cerr << "Unknown maze algorithm '" << argv[i] << "', using prim\n";
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            seedGiven = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            generator.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--numa") {
+            numa = true;
+        } else if (arg == "--bench-gen") {
+            benchGen = true;
+        } else if (arg == "--stream") {
+            streamMode = true;
+        } else if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (arg == "--load" && i + 1 < argc) {
+            loadPath = argv[++i];
+        } else if (arg == "--ctqw" && i + 1 < argc) {
+            ctqwTime = std::atof(argv[++i]);
+        } else if (arg == "--coin" && i + 1 < argc) {
+            coherent = parseQuantumCoin(argv[++i], coin);
+            if (!coherent)
+                std::cerr << "Unknown coin '" << argv[i] << "', using the classical walk\n";
+        } else if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = std::atof(argv[++i]);
+            if (!(tickRate > 0.0)) {
+                std::cerr << "Invalid tick rate '" << argv[i] << "', using " << SIM_DEFAULT_TICK_RATE << "\n";
+                tickRate = SIM_DEFAULT_TICK_RATE;
+            }
+        } else if (arg == "--headless" && i + 1 < argc) {
+            headlessTicks = std::max(0LL, std::atoll(argv[++i]));
+        } else if (arg == "--navigate") {
+            navigate = true;
+        } else if (arg == "--precision" && i + 1 < argc) {
+            if (!parseFieldPrecision(argv[++i], precision))
+                std::cerr << "Unknown precision '" << argv[i] << "', using float32\n";
+        } else if (positional == 0) {
+            gridWidth = std::atoi(argv[i]);  ++positional;
+        } else if (positional == 1) {
+            gridHeight = std::atoi(argv[i]); ++positional;
+        }
+    }
+
+    // a saved maze fixes the grid size (and the seed, to replay its run)
+    MappedMaze saved;
+    if (!loadPath.empty() && streamMode)
+        std::cerr << "--load is ignored in --stream mode\n";
+    else if (!loadPath.empty() && saved.open(loadPath)) {
+        gridWidth  = saved.width();
+        gridHeight = saved.height();
+        if (!seedGiven) seed = saved.info().seed;
+    }
+    Grid grid(gridWidth, gridHeight);
+
+    // every random stream of the run derives from this one seed
+    setMasterSeed(seed);
+    generator.rng = makeRng(RNG_STREAM_MAZE);
+    Rng& rng = threadRng();
+    std::cout << "Seed: " << seed << "\n";
+
+    if (benchGen) {
+        generator.benchmark(grid, std::cout);
+        return 0;
+    }
+
     // ---------------------------------------------------------------------
     // Window creation
     // ---------------------------------------------------------------------
-    sf::RenderWindow window(
-        sf::VideoMode(sf::Vector2u(GRID_WIDTH * NODE_SIZE,
-                                    GRID_HEIGHT * NODE_SIZE)),
+    const float mazeW = static_cast<float>(grid.width  * NODE_SIZE);
+    const float mazeH = static_cast<float>(grid.height * NODE_SIZE);
+    sf::RenderWindow window;                 // stays closed in --headless runs
+    sf::Music music;
+    if (headlessTicks == 0) {
+    window.create(
+        sf::VideoMode(sf::Vector2u(std::min(grid.width  * NODE_SIZE, 1280),
+                                   std::min(grid.height * NODE_SIZE, 960))),
         "Labyrinth: Classical vs Quantum");
+    window.setView(sf::View(sf::FloatRect({0.f, 0.f}, {mazeW, mazeH}))); // whole maze in view
    
         
     // window.setSize({640, 480});
@@ -59,7 +198,6 @@ int main()
     // Load a music to play
     
 
-    sf::Music music;
     if (!music.openFromFile("music/Elmshore - Justin Bell.mp3")){
         std::cerr << "Failed to load music\n";
     }
@@ -72,30 +210,68 @@ int main()
         static_cast<int>((desktopSize.x - winSize.x) / 2),
         static_cast<int>((desktopSize.y - winSize.y) / 2)
     ));
+    }
     // ---------------------------------------------------------------------
-    // Maze initialisation (placeholder — generation disabled for now)
+    // Maze initialisation
     // ---------------------------------------------------------------------
-    Node nodeList[GRID_WIDTH * GRID_HEIGHT];
     // initializeGrid(nodeList);
     // generateMaze(nodeList);
 
     // pick a random starting cell
-    int cur_col = std::rand() % GRID_WIDTH;
-    int cur_row = std::rand() % GRID_HEIGHT;
+    int cur_col = rng.below(grid.width);
+    int cur_row = rng.below(grid.height);
 
-    nodeList[cur_col + cur_row * GRID_WIDTH].visited = true;
     // void drawFinish(sf::RenderWindow& window, int col, int row);
     
     // make it random the finish line
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-    FINISH_COL = std::rand() % GRID_WIDTH;
-    FINISH_ROW = std::rand() % GRID_HEIGHT;
+    FINISH_COL = rng.below(grid.width);
+    FINISH_ROW = rng.below(grid.height);
     // FINISH_COL = 5;
     // FINISH_ROW = 5;
 
-    // initialize frontier walls
-    std::vector<Wall> wallVec;
-    addWalls(wallVec, nodeList, cur_col, cur_row);
+    // carve the whole maze in one go (or the first rows of the stream),
+    // or take it from the saved file with its own start and finish
+    if (streamMode) stream.begin(grid);
+    else if (saved.isOpen()) {
+        const MazeFileInfo info = saved.info();
+        saved.copyTo(grid);
+        if (info.algorithm >= 0 && info.algorithm < MAZE_ALGORITHM_COUNT)
+            generator.algorithm = static_cast<MazeAlgorithm>(info.algorithm); // for resets
+        cur_col    = std::clamp(info.startCol,  0, grid.width  - 1);
+        cur_row    = std::clamp(info.startRow,  0, grid.height - 1);
+        FINISH_COL = std::clamp(info.finishCol, 0, grid.width  - 1);
+        FINISH_ROW = std::clamp(info.finishRow, 0, grid.height - 1);
+        saved.close();
+    }
+    else generator.generate(grid, cur_col, cur_row);
+
+    // steps from every cell to the finish; refreshed lazily in the main loop
+    DistanceField finishField;
+    finishField.update(grid, FINISH_COL, FINISH_ROW);
+    if (!streamMode)
+        std::cout << "Finish is " << finishField.at(cur_col, cur_row)
+                  << " steps from the start\n";
+
+    if (ctqwTime != 0.0 && !streamMode) {
+        ContinuousWalk ctqw;
+        ctqw.initializeAt(grid, cur_col, cur_row);
+        const int products = ctqw.evolve(grid, ctqwTime);
+        std::cout << "CTQW at t=" << ctqwTime << ": P(finish) = "
+                  << ctqw.probabilityAt(FINISH_COL, FINISH_ROW)
+                  << " (" << products << " operator applications)\n";
+    }
+
+    if (!savePath.empty() && !streamMode) {
+        MazeFileInfo info;
+        info.seed      = seed;
+        info.algorithm = static_cast<int>(generator.algorithm);
+        info.startCol  = cur_col;
+        info.startRow  = cur_row;
+        info.finishCol = FINISH_COL;
+        info.finishRow = FINISH_ROW;
+        if (saveMazeFile(savePath, grid, info))
+            std::cout << "Saved maze to " << savePath << "\n";
+    }
     bool mazeReady = false;// just to check if the maze is ready
 
     //bolean to make a pase buttum
@@ -106,28 +282,25 @@ int main()
     // Particle instantiation
     // ---------------------------------------------------------------------
 
-    ClassicalParticle classical;
-
-
     // // building a bot vector
-    std::vector<ClassicalParticle*> bots={};
+    BotSystem bots;                          // structure of arrays, SIMD update
 
-    generateBots(bots, 10, nodeList);
+    generateBots(bots, 10, grid);
 
     // Place each bot on a different border cell (avoid the finish cell)
     {
         std::vector<std::pair<int,int>> border;
-        border.reserve(2 * (GRID_WIDTH + GRID_HEIGHT) - 4); // fix: reserve, not reserv
+        border.reserve(2 * (grid.width + grid.height)); // fix: reserve, not reserv
 
         // Top and bottom rows
-        for (int c = 0; c < GRID_WIDTH; ++c) {
+        for (int c = 0; c < grid.width; ++c) {
             border.emplace_back(c, 0);
-            if (GRID_HEIGHT > 1) border.emplace_back(c, GRID_HEIGHT - 1);
+            if (grid.height > 1) border.emplace_back(c, grid.height - 1);
         }
         // Left and right columns (skip corners)
-        for (int r = 1; r < GRID_HEIGHT - 1; ++r) {
+        for (int r = 1; r < grid.height - 1; ++r) {
             border.emplace_back(0, r);
-            if (GRID_WIDTH > 1) border.emplace_back(GRID_WIDTH - 1, r);
+            if (grid.width > 1) border.emplace_back(grid.width - 1, r);
         }
 
         // Remove finish if it’s on the border
@@ -138,13 +311,12 @@ int main()
             border.end());
 
         // Shuffle and assign unique border cells to bots
-        std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
         std::shuffle(border.begin(), border.end(), rng);
 
         const size_t count = std::min(bots.size(), border.size());
         for (size_t i = 0; i < count; ++i) {
             const auto [c, r] = border[i];
-            bots[i]->setPosition(c, r, nodeList);
+            bots.setPosition(i, c, r, grid);
         }
     }
 
@@ -153,11 +325,27 @@ int main()
 
     // QuantumParticle quantum;
     // quantum.initialize(nodeList);
+    // persistent workers for the quantum walk (none with --threads 1)
+    ThreadPool workers(generator.threads);
+    workers.firstTouch = numa;
+
     QuantumParticle quantum;
-    quantum.initialize(nodeList);
+    quantum.pool = &workers;
+    if (coherent)
+    {
+        quantum.initializeCoherent(grid, cur_col, cur_row, coin);
+        std::cout << "Coined quantum walk (" << QuantumWalk::kernelName() << " kernels)\n";
+    }
+    else
+    {
+        quantum.setPrecision(grid, precision);   // first: initialize() builds the packed field directly
+        quantum.initialize(grid);
+    }
 
-    std::vector<QuantumParticle*> qbots;
-    QuantumParticle::addQuantumParticle(qbots, 100, nodeList);
+    // 100 quantum bots evolved together over the shared maze topology
+    // (fewer on big grids: initialize() keeps them within their memory cap)
+    QuantumEnsemble qbots;
+    qbots.initialize(grid, 100);
     
 
     //seting the collapese to make it stops only when the space key is pressed
@@ -172,6 +360,32 @@ int main()
     };
     player.color = sf::Color::Green; // default colour
 
+    // fixed-timestep world: frames only decide how often it is drawn
+    Simulation sim(grid, player, bots, quantum, qbots, finishField,
+                   streamMode ? &stream : nullptr);
+    sim.tickRate = tickRate;
+    sim.navigate = navigate;
+
+    if (headlessTicks > 0) {
+        // no window, no input: the same ticks a GUI run with idle keys takes
+        SimulationInput idle;
+        long long finishes = 0;
+        sf::Clock wall;
+        for (long long t = 0; t < headlessTicks; ++t) {
+            if (sim.step(idle) | sim.measure()) {   // measured every tick: replays tick for tick
+                ++finishes;                  // someone reached the finish: new round
+                resetGame(grid, generator, player, bots, mazeReady, cur_col, cur_row,
+                          streamMode ? &stream : nullptr, &finishField);
+            }
+        }
+        const double seconds = wall.getElapsedTime().asSeconds();
+        std::cout << headlessTicks << " ticks in " << seconds << " s ("
+                  << headlessTicks / std::max(seconds, 1e-9) << " ticks/s), "
+                  << finishes << " finishes, player at (" << player.col << "," << player.row
+                  << "), quantum at (" << quantum.col << "," << quantum.row << ")\n";
+        return 0;
+    }
+
 
     // ---------------------------------------------------------------------
     // Main loop
@@ -197,7 +411,9 @@ int main()
             }
             if (auto key = event->getIf<sf::Event::KeyPressed>()) {
                 if (key->code == sf::Keyboard::Key::R) { // Reset game with 'R'
-                    resetGame(nodeList, wallVec, player, bots, mazeReady, cur_col, cur_row);
+                    resetGame(grid, generator, player, bots, mazeReady, cur_col, cur_row,
+                              streamMode ? &stream : nullptr, &finishField);
+                    sim.snapshot();                      // no interpolation across the reset
                 }
             }
 
@@ -217,30 +433,7 @@ int main()
 
         //--——————————————————————————————— the maze
 
-        if (!wallVec.empty()) {
-            int idx = std::rand() % wallVec.size();
-            Wall w = wallVec[idx];
-            Node* a = w.node1;
-            Node* b = w.node2;
-
-            if ((a->visited && !b->visited) || (!a->visited && b->visited)) {
-                joinNodes(nodeList, a, b);
-                Node* next = a->visited ? b : a;
-                next->visited = true;
-
-                int ni = static_cast<int>(next - nodeList);
-                cur_row = ni / GRID_WIDTH;
-                cur_col = ni % GRID_WIDTH;
-                addWalls(wallVec, nodeList, cur_col, cur_row);
-
-
-
-            }
-
-
-            wallVec.erase(wallVec.begin() + idx);
-        }
-        else if (!mazeReady) {
+        if (!mazeReady) {
             // Maze generation is complete
             mazeReady = true;
             // std::cout << "Maze generation complete.\n";
@@ -249,27 +442,25 @@ int main()
         {
             int c,r;
             do {
-                c = std::rand() % GRID_WIDTH;
-                r = std::rand() % GRID_HEIGHT;
-            } while (c == FINISH_COL && r == FINISH_ROW);
-            classical.setPosition(c, r, nodeList);
+                c = rng.below(grid.width);
+                r = rng.below(grid.height);
+            } while (c == FINISH_COL && r == FINISH_ROW && grid.cellCount() > 1);
+            classical.setPosition(c, r, grid);
         }
         }
 
 
 
+        // frame time in seconds; restarted while paused too, so a pause
+        // is not simulated afterwards
+        const double frameSeconds = clock.restart().asSeconds();
+
         //put the pause
         if(!pause){
  
             // ——— Simulation update ———————————————————————————————
-            float dt = clock.restart().asSeconds();        // frame time in seconds
-
-
             if(mazeReady)
             {
-
-                const float speed =100.f;  // pixels per second
-
                 sf::Vector2f dir{0.f, 0.f};
                 if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) || 
                 sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))
@@ -289,25 +480,14 @@ int main()
                     dir /= len;
                 }
 
-                // set the player velocity:
-                player.velocity = dir * speed;
+                // the ticks due this frame: move, collide, scroll, walk, measure
+                SimulationInput input;
+                input.move         = dir;
+                input.autoCollapse = autoCollapse;
+                const unsigned events = sim.advance(frameSeconds, input);
 
-                // now integrate & collide:
-                player.update(dt, nodeList);
-                // change the logic to suport the new version 
-
-                for (auto& bot : bots) {
-                    bot->update(dt, nodeList);
-                }
-                
-                //trying to set the postion so the particle is in the right place and computs
-                player.col = static_cast<int>(player.position.x / NODE_SIZE);
-                player.row = static_cast<int>(player.position.y / NODE_SIZE);
-                
-                player.setPosition(player.col, player.row, nodeList);
 
-
-                if (player.col == FINISH_COL && player.row == FINISH_ROW) {
+                if (events & SIM_PLAYER_FINISHED) {
 
                     pause = true; // Pause the game
                     sf::Texture winTexture;
@@ -316,7 +496,7 @@ int main()
                     } else {
 
                         sf::Sprite winSprite(winTexture);
-                        winSprite.setPosition({GRID_WIDTH/2, GRID_HEIGHT/2}); // Set position to top-left corner
+                        winSprite.setPosition({grid.width / 2.f, grid.height / 2.f}); // Set position to top-left corner
                         while (pause && window.isOpen()) {
                             if (const auto event = window.pollEvent()) { // Use std::optional<sf::Event>
                                 if (event->is<sf::Event::Closed>()) {    // Check if the event is a window close request
@@ -325,7 +505,9 @@ int main()
                                 if (event->is<sf::Event::KeyPressed>()) {
                                     if (event->getIf<sf::Event::KeyPressed>()->code == sf::Keyboard::Key::R) {
                                         // Reset the game when 'R' is pressed
-                                        resetGame(nodeList, wallVec, player, bots, mazeReady, cur_col, cur_row);
+                                        resetGame(grid, generator, player, bots, mazeReady, cur_col, cur_row,
+                                                  streamMode ? &stream : nullptr, &finishField);
+                                        sim.snapshot();
                                         pause = false; // Resume the game
                                     }
                                 }
@@ -340,26 +522,18 @@ int main()
                 }
 
 
-                // Ajusting the logic to the new version of the bots
-                for (auto& bot : bots) {
-                    bot->col = static_cast<int>(bot->position.x / NODE_SIZE);
-                    bot->row = static_cast<int>(bot->position.y / NODE_SIZE);
-                    bot->setPosition(bot->col, bot->row, nodeList);
-                }
                 // Check if any bot has reached the finish line
-
-
-                // after you update your bots:
-                for (auto& bot : bots) {
-                    if (bot->col == FINISH_COL && bot->row == FINISH_ROW || quantum.col == FINISH_COL && quantum.row == FINISH_ROW) {
+                // (a win in the same tick takes precedence)
+                {
+                    if ((events & SIM_OPPONENT_FINISHED) && !(events & SIM_PLAYER_FINISHED)) {
                         pause = true; // Pause the game
                         sf::Texture loseTexture;
                         if (!loseTexture.loadFromFile("imagen/trem.jpg")) { // Replace with your image path
                             std::cerr << "Failed to load lose image\n";
                         } else {
                             sf::Sprite loseSprite(loseTexture);
-                            loseSprite.setPosition( {GRID_WIDTH/2, GRID_HEIGHT/2} );
-                            loseSprite.setScale ({GRID_WIDTH/4, GRID_HEIGHT/4}); // Adjust the scale as needed
+                            loseSprite.setPosition( {grid.width / 2.f, grid.height / 2.f} );
+                            loseSprite.setScale ({static_cast<float>(grid.width / 4), static_cast<float>(grid.height / 4)}); // Adjust the scale as needed
                             std::cout << "YOU LOSE!\n";
                             while (pause && window.isOpen()) {
                                 if (const auto event = window.pollEvent()) { // Use std::optional<sf::Event>
@@ -369,7 +543,9 @@ int main()
                                     if (event->is<sf::Event::KeyPressed>()) {
                                         if (event->getIf<sf::Event::KeyPressed>()->code == sf::Keyboard::Key::R) {
                                             // Reset the game when 'R' is pressed
-                                            resetGame(nodeList, wallVec, player, bots, mazeReady, cur_col, cur_row);
+                                            resetGame(grid, generator, player, bots, mazeReady, cur_col, cur_row,
+                                                      streamMode ? &stream : nullptr, &finishField);
+                                            sim.snapshot();
                                             pause = false; // Resume the game
                                         }
                                     }
@@ -385,35 +561,25 @@ int main()
                     }
                 }
             }
-
-
-            if (autoCollapse)
-            {
-                // prepare the next frame
-                if (quantum.collapsed)                     // was frozen last frame
-                    quantum.collapsed = false;             // “un‑collapse” so it can walk
-        
-                quantum.evolve(nodeList);                 // quantum walk
-                quantum.collapse();                       // immediate measurement
-            }
         }
         // ——— Rendering ———————————————————————————————————————
         window.clear(sf::Color::Black);
-        drawMaze(window, nodeList, -1, 1); // -1 disables path highlighting
+        drawMaze(window, grid, -1, 1); // -1 disables path highlighting
         
         if(mazeReady){
 
             drawFinish(window, FINISH_COL, FINISH_ROW);
             
             
-            player.draw(window);
+            PlayerParticle shown = player;     // drawn between the last two ticks
+            shown.position = sim.playerDrawPosition();
+            shown.draw(window);
 
-            for (auto& bot : bots) {
-                bot->draw(window);
-            }
+            sim.drawBots(window);
 
 
-            quantum.draw(window);
+            quantum.draw(window, grid);
+            qbots.draw(window);
         }
         if(pause){
             //insert a imagem of pause on all the screen
@@ -0,0 +1,188 @@
+// =============================================================================
+// mazeFile.cpp — `.qmaze` save / mmap load
+//
+// Saving streams the header and the two wall bitplanes with std::ofstream.
+// Loading maps the file read-only; validation only touches the header page,
+// so opening a multi-megabyte maze costs a few syscalls.
+// =============================================================================
+
+#include "../include/mazeFile.hpp"
+#include <algorithm>           // std::copy, std::fill
+#include <cstring>             // std::memcmp, std::memcpy
+#include <fstream>             // std::ofstream
+#include <iostream>            // std::cerr
+#include <fcntl.h>             // ::open
+#include <sys/mman.h>          // mmap, munmap
+#include <sys/stat.h>          // fstat
+#include <unistd.h>            // ::close
+
+static const char MAZE_FILE_MAGIC[8] = { 'Q', 'M', 'A', 'Z', 'E', 0, 0, 0 };
+
+static_assert(sizeof(MazeFileHeader) <= MAZE_FILE_PLANE_OFFSET,
+              "MazeFileHeader must fit before the first plane");
+
+/* ------------------------------------------------------------------------- */
+/* saveMazeFile                                                              */
+/* ------------------------------------------------------------------------- */
+bool saveMazeFile(const std::string& path, const Grid& grid, const MazeFileInfo& info)
+{
+    MazeFileHeader header{};
+    std::memcpy(header.magic, MAZE_FILE_MAGIC, sizeof header.magic);
+    header.version     = MAZE_FILE_VERSION;
+    header.headerBytes = sizeof(MazeFileHeader);
+    header.width       = static_cast<std::uint32_t>(grid.width);
+    header.height      = static_cast<std::uint32_t>(grid.height);
+    header.stride      = static_cast<std::uint32_t>(grid.stride);
+    header.algorithm   = static_cast<std::uint32_t>(info.algorithm);
+    header.seed        = info.seed;
+    header.startCol    = info.startCol;
+    header.startRow    = info.startRow;
+    header.finishCol   = info.finishCol;
+    header.finishRow   = info.finishRow;
+    header.planeOffset = MAZE_FILE_PLANE_OFFSET;
+    header.planeWords  = grid.openRight.size();
+
+    char block[MAZE_FILE_PLANE_OFFSET] = {};
+    std::memcpy(block, &header, sizeof header);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(block, sizeof block);
+    out.write(reinterpret_cast<const char*>(grid.openRight.data()),
+              static_cast<std::streamsize>(grid.openRight.size() * sizeof(std::uint64_t)));
+    out.write(reinterpret_cast<const char*>(grid.openDown.data()),
+              static_cast<std::streamsize>(grid.openDown.size() * sizeof(std::uint64_t)));
+    if (!out)
+    {
+        std::cerr << "Failed to write maze file " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* MappedMaze                                                                */
+/* ------------------------------------------------------------------------- */
+MappedMaze::~MappedMaze()
+{
+    close();
+}
+
+void MappedMaze::close()
+{
+    if (base) munmap(base, length);
+    base   = nullptr;
+    length = 0;
+    header = nullptr;
+    planes = nullptr;
+}
+
+/** Map @p path and check the header against the file size, so every later
+ *  plane access stays inside the mapping.
+ */
+bool MappedMaze::open(const std::string& path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open maze file " << path << "\n";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(MAZE_FILE_PLANE_OFFSET))
+    {
+        std::cerr << "Maze file " << path << " is truncated\n";
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    void* mem = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);                                  // the mapping keeps the file alive
+    if (mem == MAP_FAILED)
+    {
+        std::cerr << "Failed to map maze file " << path << "\n";
+        length = 0;
+        return false;
+    }
+    base = mem;
+
+    const MazeFileHeader* h = static_cast<const MazeFileHeader*>(base);
+    const std::uint64_t stride = (static_cast<std::uint64_t>(h->width) + 63) / 64;
+    const char* problem = nullptr;
+    if (std::memcmp(h->magic, MAZE_FILE_MAGIC, sizeof h->magic) != 0)
+        problem = "is not a maze file";
+    else if (h->version != MAZE_FILE_VERSION)
+        problem = "has an unsupported version";
+    else if (h->width < 1 || h->width > MAX_GRID_DIM || h->height < 1 || h->height > MAX_GRID_DIM
+             || h->stride != stride || h->planeWords != stride * h->height
+             || h->planeOffset % sizeof(std::uint64_t) != 0)
+        problem = "has an invalid header";
+    else if (h->planeOffset + 2 * h->planeWords * sizeof(std::uint64_t) > length)
+        problem = "is truncated";
+    if (problem)
+    {
+        std::cerr << "Maze file " << path << " " << problem << "\n";
+        close();
+        return false;
+    }
+
+    header = h;
+    planes = reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(base) + h->planeOffset);
+    madvise(base, length, MADV_WILLNEED);         // start readahead of the planes
+    return true;
+}
+
+MazeFileInfo MappedMaze::info() const
+{
+    MazeFileInfo i;
+    i.seed      = header->seed;
+    i.algorithm = static_cast<int>(header->algorithm);
+    i.startCol  = header->startCol;
+    i.startRow  = header->startRow;
+    i.finishCol = header->finishCol;
+    i.finishRow = header->finishRow;
+    return i;
+}
+
+void MappedMaze::copyTo(Grid& grid) const
+{
+    if (grid.width != width() || grid.height != height())
+        grid = Grid(width(), height());
+
+    const std::size_t words = header->planeWords;
+    std::copy(openRight(), openRight() + words, grid.openRight.begin());
+    std::copy(openDown(),  openDown()  + words, grid.openDown.begin());
+
+    // every real cell is visited; padding bits of the last word stay clear
+    const int tail = width() % 64;
+    const std::uint64_t lastWord = tail ? (std::uint64_t(1) << tail) - 1 : ~std::uint64_t(0);
+    for (int r = 0; r < height(); ++r)
+    {
+        std::uint64_t* row = &grid.visited[static_cast<std::size_t>(r) * grid.stride];
+        std::fill(row, row + grid.stride - 1, ~std::uint64_t(0));
+        row[grid.stride - 1] = lastWord;
+    }
+
+    // The planes come from disk: exits through the outer border or in the
+    // padding bits would send the evolve kernels, sweepCircle and the BFS
+    // off the grid, so they are closed here
+    const std::uint64_t lastCol = std::uint64_t(1) << ((width() - 1) % 64);
+    std::size_t dropped = 0;
+    auto keep = [&dropped](std::uint64_t& word, std::uint64_t mask) {
+        dropped += __builtin_popcountll(word & ~mask);
+        word &= mask;
+    };
+    for (int r = 0; r < height(); ++r)
+    {
+        const std::size_t last = static_cast<std::size_t>(r) * grid.stride + grid.stride - 1;
+        keep(grid.openRight[last], lastWord & ~lastCol);        // no RIGHT exit off the last column
+        keep(grid.openDown[last],  lastWord);
+    }
+    const std::size_t bottom = static_cast<std::size_t>(height() - 1) * grid.stride;
+    for (int w = 0; w < grid.stride; ++w)
+        keep(grid.openDown[bottom + w], 0);                     // no DOWN exit off the last row
+    if (dropped)
+        std::cerr << "Maze file opens " << dropped << " walls outside the grid; they stay closed\n";
+    grid.touch();
+}
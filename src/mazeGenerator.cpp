@@ -0,0 +1,527 @@
+// =============================================================================
+// mazeGenerator.cpp — Batch maze generators
+//
+// The game used to run Prim's algorithm inside main(), one wall per frame,
+// on a std::vector<Wall> holding two raw pointers per entry and erasing from
+// the middle of the vector.  MazeGenerator carves the whole maze in one call
+// with one of several algorithms (see MazeAlgorithm):
+//
+//   • Prim        — 32-bit EdgeId frontier, swap-and-pop, 1 bit per edge
+//                   stops duplicates from being pushed
+//   • Kruskal     — shuffled edge list + union-find (rank, path halving)
+//   • Wilson      — loop-erased random walks into the growing tree
+//   • Backtracker — depth-first carving with an explicit stack
+//   • Eller       — one row at a time, O(width) set state (EllerRows)
+//
+// Grids bigger than one tile are carved tile by tile, on worker threads
+// when `threads > 1`, and the tiles are joined along a coarse spanning
+// tree (generateTiled).
+//
+// Every algorithm writes straight into the Grid bitplanes and leaves every
+// cell marked visited.
+// =============================================================================
+
+#include "../include/mazeGenerator.hpp"
+#include <algorithm>           // std::swap, std::min, std::max
+#include <atomic>              // tile work counter
+#include <chrono>              // benchmark timing
+#include <iostream>            // benchmark report
+#include <thread>              // tile workers
+
+/* ------------------------------------------------------------------------- */
+/* Algorithm names                                                           */
+/* ------------------------------------------------------------------------- */
+static const char* const ALGORITHM_NAMES[MAZE_ALGORITHM_COUNT] = {
+    "prim", "kruskal", "wilson", "backtracker", "eller"
+};
+
+const char* mazeAlgorithmName(MazeAlgorithm algo)
+{
+    return ALGORITHM_NAMES[static_cast<int>(algo)];
+}
+
+bool parseMazeAlgorithm(const std::string& name, MazeAlgorithm& out)
+{
+    for (int i = 0; i < MAZE_ALGORITHM_COUNT; ++i)
+    {
+        if (name == ALGORITHM_NAMES[i])
+        {
+            out = static_cast<MazeAlgorithm>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ------------------------------------------------------------------------- */
+/* edgeId                                                                    */
+/* ------------------------------------------------------------------------- */
+EdgeId MazeGenerator::edgeId(int cell, int side, int width)
+{
+    switch (side)
+    {
+        case SIDE_RIGHT: return static_cast<EdgeId>(cell) * 2u;
+        case SIDE_DOWN:  return static_cast<EdgeId>(cell) * 2u + 1u;
+        case SIDE_LEFT:  return static_cast<EdgeId>(cell - 1) * 2u;
+        default:         return static_cast<EdgeId>(cell - width) * 2u + 1u;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* generate                                                                  */
+/* ------------------------------------------------------------------------- */
+/** Clear the grid and dispatch to the selected algorithm. */
+void MazeGenerator::generate(Grid& grid, int startCol, int startRow)
+{
+    grid.reset();
+    if (!indexIsValid(grid, startCol, startRow)) return;
+
+    // tiled at any thread count, so the maze only depends on the seed
+    if (grid.width > MAZE_TILE_COLS || grid.height > MAZE_TILE_ROWS)
+    {
+        generateTiled(grid);
+        return;
+    }
+
+    switch (algorithm)
+    {
+        case MazeAlgorithm::Prim:        generatePrim(grid, startCol, startRow);        break;
+        case MazeAlgorithm::Kruskal:     generateKruskal(grid);                         break;
+        case MazeAlgorithm::Wilson:      generateWilson(grid, startCol, startRow);      break;
+        case MazeAlgorithm::Backtracker: generateBacktracker(grid, startCol, startRow); break;
+        case MazeAlgorithm::Eller:       generateEller(grid);                           break;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Prim                                                                      */
+/* ------------------------------------------------------------------------- */
+void MazeGenerator::pushEdges(Grid& grid, int cell)
+{
+    const int col = cell % grid.width;
+    const int row = cell / grid.width;
+
+    for (int side = 0; side < 4; ++side)
+    {
+        int nc = nextCol(col, side);
+        int nr = nextRow(row, side);
+        if (!indexIsValid(grid, nc, nr) || grid.isVisited(nc, nr))
+            continue;
+
+        EdgeId e = edgeId(cell, side, grid.width);
+        std::uint64_t bit = std::uint64_t{1} << (e & 63u);
+        std::uint64_t& word = edgeSeen[e >> 6];
+        if (word & bit) continue;            // already in the frontier
+        word |= bit;
+        frontier.push_back(e);
+    }
+}
+
+/** Carve a perfect maze with randomized Prim, starting at (startCol,startRow).
+ *
+ *  The loop is the same one main() used to run per frame: pick a random
+ *  frontier wall and, if it separates the tree from an unvisited cell, knock
+ *  it down and grow the frontier from the new cell.  Every wall enters the
+ *  frontier at most once, so the whole run is O(cells).
+ */
+void MazeGenerator::generatePrim(Grid& grid, int startCol, int startRow)
+{
+    const std::size_t cells = static_cast<std::size_t>(grid.cellCount());
+
+    frontier.clear();
+    frontier.reserve(cells * 2);
+    edgeSeen.assign((cells * 2 + 63) / 64, 0);
+
+    grid.markVisited(startCol, startRow);
+    pushEdges(grid, grid.index(startCol, startRow));
+
+    while (!frontier.empty())
+    {
+        std::size_t idx = rng.below(static_cast<std::uint32_t>(frontier.size()));
+        EdgeId e = frontier[idx];
+        frontier[idx] = frontier.back();     // swap-and-pop
+        frontier.pop_back();
+
+        const int a = edgeCellA(e);
+        const int b = edgeCellB(e, grid.width);
+        const bool aVisited = grid.isVisited(a % grid.width, a / grid.width);
+        const bool bVisited = grid.isVisited(b % grid.width, b / grid.width);
+        if (aVisited == bVisited) continue;
+
+        // the edge owner always keeps the shared bit
+        grid.openWall(a % grid.width, a / grid.width, (e & 1u) ? SIDE_DOWN : SIDE_RIGHT);
+        const int next = aVisited ? b : a;
+        grid.markVisited(next % grid.width, next / grid.width);
+        pushEdges(grid, next);
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Kruskal                                                                   */
+/* ------------------------------------------------------------------------- */
+std::uint32_t MazeGenerator::findRoot(std::uint32_t x)
+{
+    while (parent[x] != x)
+    {
+        parent[x] = parent[parent[x]];       // path halving
+        x = parent[x];
+    }
+    return x;
+}
+
+/** Shuffle every interior wall and knock it down whenever it separates two
+ *  different union-find sets.  Stops as soon as cells-1 walls are open.
+ */
+void MazeGenerator::generateKruskal(Grid& grid)
+{
+    const int cells = grid.cellCount();
+
+    frontier.clear();
+    frontier.reserve(static_cast<std::size_t>(cells) * 2);
+    for (int r = 0; r < grid.height; ++r)
+        for (int c = 0; c < grid.width; ++c)
+        {
+            const int cell = grid.index(c, r);
+            if (c + 1 < grid.width)  frontier.push_back(edgeId(cell, SIDE_RIGHT, grid.width));
+            if (r + 1 < grid.height) frontier.push_back(edgeId(cell, SIDE_DOWN,  grid.width));
+        }
+
+    // Fisher–Yates
+    for (std::size_t i = frontier.size(); i > 1; --i)
+        std::swap(frontier[i - 1], frontier[rng.below(static_cast<std::uint32_t>(i))]);
+
+    parent.resize(cells);
+    for (int i = 0; i < cells; ++i) parent[i] = static_cast<std::uint32_t>(i);
+    walkDir.assign(cells, 0);                // union rank
+
+    int joined = 0;
+    for (EdgeId e : frontier)
+    {
+        if (joined == cells - 1) break;
+
+        std::uint32_t ra = findRoot(static_cast<std::uint32_t>(edgeCellA(e)));
+        std::uint32_t rb = findRoot(static_cast<std::uint32_t>(edgeCellB(e, grid.width)));
+        if (ra == rb) continue;
+
+        if (walkDir[ra] < walkDir[rb]) std::swap(ra, rb);
+        parent[rb] = ra;
+        if (walkDir[ra] == walkDir[rb]) ++walkDir[ra];
+
+        const int a = edgeCellA(e);
+        grid.openWall(a % grid.width, a / grid.width, (e & 1u) ? SIDE_DOWN : SIDE_RIGHT);
+        ++joined;
+    }
+
+    for (int r = 0; r < grid.height; ++r)
+        for (int c = 0; c < grid.width; ++c)
+            grid.markVisited(c, r);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Wilson                                                                    */
+/* ------------------------------------------------------------------------- */
+/** Uniform spanning tree by loop-erased random walks.
+ *
+ *  From every cell not yet in the tree, walk randomly until the tree is
+ *  hit, remembering only the *last* exit taken from each cell (this erases
+ *  loops implicitly), then retrace the walk and carve it into the tree.
+ */
+void MazeGenerator::generateWilson(Grid& grid, int startCol, int startRow)
+{
+    walkDir.assign(static_cast<std::size_t>(grid.cellCount()), 0);
+    grid.markVisited(startCol, startRow);
+
+    for (int r0 = 0; r0 < grid.height; ++r0)
+        for (int c0 = 0; c0 < grid.width; ++c0)
+        {
+            if (grid.isVisited(c0, r0)) continue;
+
+            // 1) random walk until the tree is reached
+            int c = c0, r = r0;
+            while (!grid.isVisited(c, r))
+            {
+                int side, nc, nr;
+                do {
+                    side = static_cast<int>(rng() & 3u);
+                    nc = nextCol(c, side);
+                    nr = nextRow(r, side);
+                } while (!indexIsValid(grid, nc, nr));
+
+                walkDir[grid.index(c, r)] = static_cast<std::uint8_t>(side);
+                c = nc;
+                r = nr;
+            }
+
+            // 2) retrace the loop-erased path and add it to the tree
+            c = c0;
+            r = r0;
+            while (!grid.isVisited(c, r))
+            {
+                const int side = walkDir[grid.index(c, r)];
+                grid.markVisited(c, r);
+                grid.openWall(c, r, side);
+                c = nextCol(c, side);
+                r = nextRow(r, side);
+            }
+        }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Backtracker                                                               */
+/* ------------------------------------------------------------------------- */
+/** Depth-first carving.  `parent` is reused as the explicit cell stack so
+ *  deep mazes never touch the call stack.
+ */
+void MazeGenerator::generateBacktracker(Grid& grid, int startCol, int startRow)
+{
+    std::vector<std::uint32_t>& stack = parent;
+    stack.clear();
+
+    grid.markVisited(startCol, startRow);
+    stack.push_back(static_cast<std::uint32_t>(grid.index(startCol, startRow)));
+
+    while (!stack.empty())
+    {
+        const int cell = static_cast<int>(stack.back());
+        const int col  = cell % grid.width;
+        const int row  = cell / grid.width;
+
+        int options[4];
+        int count = 0;
+        for (int side = 0; side < 4; ++side)
+        {
+            int nc = nextCol(col, side);
+            int nr = nextRow(row, side);
+            if (indexIsValid(grid, nc, nr) && !grid.isVisited(nc, nr))
+                options[count++] = side;
+        }
+
+        if (count == 0)
+        {
+            stack.pop_back();                // dead end, backtrack
+            continue;
+        }
+
+        const int side = options[rng.below(static_cast<std::uint32_t>(count))];
+        const int nc = nextCol(col, side);
+        const int nr = nextRow(row, side);
+        grid.openWall(col, row, side);
+        grid.markVisited(nc, nr);
+        stack.push_back(static_cast<std::uint32_t>(grid.index(nc, nr)));
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Eller                                                                     */
+/* ------------------------------------------------------------------------- */
+void MazeGenerator::generateEller(Grid& grid)
+{
+    eller.begin(grid.width, (static_cast<std::uint64_t>(rng()) << 32) | rng());
+    for (int r = 0; r < grid.height; ++r)
+    {
+        const std::size_t w = static_cast<std::size_t>(r) * grid.stride;
+        eller.nextRow(&grid.openRight[w], &grid.openDown[w], r == grid.height - 1);
+        for (int c = 0; c < grid.width; ++c)
+            grid.markVisited(c, r);
+    }
+}
+
+void EllerRows::begin(int w, std::uint64_t seed)
+{
+    rng.seed(seed);
+    width = w;
+    setOf.assign(w, -1);
+    nextInSet.assign(w, -1);
+    head.assign(w, -1);
+    tail.assign(w, -1);
+    size.assign(w, 0);
+    freeLabels.clear();
+    for (int label = w - 1; label >= 0; --label)
+        freeLabels.push_back(label);
+}
+
+/** Produce one row of Eller's algorithm.
+ *
+ *  1. Columns carried down from the previous row keep their label, new
+ *     columns get a fresh one; per-label member lists are rebuilt.
+ *  2. Neighbours in different sets are joined at random (always on the
+ *     last row); the smaller list is relabelled into the larger one.
+ *  3. Every set sends at least one random member down; columns that do
+ *     not go down start the next row without a set.
+ */
+void EllerRows::nextRow(std::uint64_t* right, std::uint64_t* down, bool lastRow)
+{
+    // 1) labels and member lists
+    for (int c = 0; c < width; ++c)
+    {
+        if (setOf[c] < 0)
+        {
+            setOf[c] = freeLabels.back();
+            freeLabels.pop_back();
+        }
+        head[setOf[c]] = -1;
+        size[setOf[c]] = 0;
+    }
+    for (int c = 0; c < width; ++c)
+    {
+        const int label = setOf[c];
+        nextInSet[c] = -1;
+        if (head[label] < 0) head[label] = c;
+        else                 nextInSet[tail[label]] = c;
+        tail[label] = c;
+        ++size[label];
+    }
+
+    // 2) horizontal joins
+    for (int c = 0; c + 1 < width; ++c)
+    {
+        int a = setOf[c];
+        int b = setOf[c + 1];
+        if (a == b || (!lastRow && (rng() & 1u))) continue;
+
+        right[c >> 6] |= std::uint64_t{1} << (c & 63);
+
+        if (size[a] < size[b]) std::swap(a, b);   // relabel the smaller set
+        for (int m = head[b]; m >= 0; m = nextInSet[m])
+            setOf[m] = a;
+        nextInSet[tail[a]] = head[b];
+        tail[a]  = tail[b];
+        size[a] += size[b];
+        freeLabels.push_back(b);
+    }
+
+    if (lastRow) return;
+
+    // 3) vertical connections, at least one per set
+    for (int c = 0; c < width; ++c)
+    {
+        const int label = setOf[c];
+        if (head[label] != c) continue;      // visit each set once, at its head
+
+        const int members = size[label];
+        int chosen = 0;
+        for (int m = head[label]; m >= 0; m = nextInSet[m])
+            if (rng() & 1u)
+            {
+                down[m >> 6] |= std::uint64_t{1} << (m & 63);
+                ++chosen;
+            }
+        if (chosen == 0)
+        {
+            int pick = static_cast<int>(rng.below(static_cast<std::uint32_t>(members)));
+            int m = head[label];
+            while (pick-- > 0) m = nextInSet[m];
+            down[m >> 6] |= std::uint64_t{1} << (m & 63);
+        }
+    }
+
+    // columns that did not go down leave their set
+    for (int c = 0; c < width; ++c)
+        if (!((down[c >> 6] >> (c & 63)) & 1u))
+            setOf[c] = -1;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Tiled parallel generation                                                 */
+/* ------------------------------------------------------------------------- */
+/** Carve every tile concurrently, then stitch the tiles together.
+ *
+ *  1. Workers pull tile indices from an atomic counter.  Each one owns a
+ *     MazeGenerator and a tile-sized Grid, carves the tile with `algorithm`
+ *     and copies the words into place (tiles are 64-column aligned, so no
+ *     two workers ever write the same word).  Tile t uses stream t of one
+ *     seed, so the maze does not depend on thread scheduling.
+ *  2. A spanning tree over the coarse tilesX x tilesY grid (itself a maze)
+ *     decides which tiles touch; one random wall is opened along each of
+ *     those seams.  Trees joined by a tree of single edges form a tree.
+ */
+void MazeGenerator::generateTiled(Grid& grid)
+{
+    const int tilesX    = (grid.width  + MAZE_TILE_COLS - 1) / MAZE_TILE_COLS;
+    const int tilesY    = (grid.height + MAZE_TILE_ROWS - 1) / MAZE_TILE_ROWS;
+    const int tileCount = tilesX * tilesY;
+
+    const std::uint64_t tileSeed = (static_cast<std::uint64_t>(rng()) << 32) | rng();
+
+    std::atomic<int> nextTile{0};
+    auto worker = [&]()
+    {
+        MazeGenerator local;
+        local.algorithm = algorithm;
+        Grid tile(1, 1);
+
+        for (int t = nextTile.fetch_add(1); t < tileCount; t = nextTile.fetch_add(1))
+        {
+            const int col0 = (t % tilesX) * MAZE_TILE_COLS;
+            const int row0 = (t / tilesX) * MAZE_TILE_ROWS;
+            const int tw   = std::min(MAZE_TILE_COLS, grid.width  - col0);
+            const int th   = std::min(MAZE_TILE_ROWS, grid.height - row0);
+            if (tile.width != tw || tile.height != th) tile = Grid(tw, th);
+
+            local.rng.seed(tileSeed, static_cast<std::uint64_t>(t)); // stream per tile
+            local.generate(tile, tw / 2, th / 2);
+
+            for (int r = 0; r < th; ++r)
+            {
+                const std::size_t dst = static_cast<std::size_t>(row0 + r) * grid.stride + col0 / 64;
+                const std::size_t src = static_cast<std::size_t>(r) * tile.stride;
+                std::copy_n(&tile.openRight[src], tile.stride, &grid.openRight[dst]);
+                std::copy_n(&tile.openDown[src],  tile.stride, &grid.openDown[dst]);
+                std::copy_n(&tile.visited[src],   tile.stride, &grid.visited[dst]);
+            }
+        }
+    };
+
+    const int workers = std::max(1, std::min(threads, tileCount));
+    std::vector<std::thread> pool;
+    for (int i = 1; i < workers; ++i) pool.emplace_back(worker);
+    worker();                                // the calling thread works too
+    for (std::thread& t : pool) t.join();
+
+    // stitch the seams along a spanning tree of the tile grid
+    Grid coarse(tilesX, tilesY);
+    MazeGenerator stitcher;
+    stitcher.rng.seed(rng());
+    stitcher.generate(coarse, 0, 0);
+
+    for (int ty = 0; ty < tilesY; ++ty)
+        for (int tx = 0; tx < tilesX; ++tx)
+        {
+            const int col0 = tx * MAZE_TILE_COLS;
+            const int row0 = ty * MAZE_TILE_ROWS;
+            const int tw   = std::min(MAZE_TILE_COLS, grid.width  - col0);
+            const int th   = std::min(MAZE_TILE_ROWS, grid.height - row0);
+
+            if (!coarse.hasWall(tx, ty, SIDE_RIGHT))
+                grid.openWall(col0 + tw - 1, row0 + static_cast<int>(rng.below(th)), SIDE_RIGHT);
+            if (!coarse.hasWall(tx, ty, SIDE_DOWN))
+                grid.openWall(col0 + static_cast<int>(rng.below(tw)), row0 + th - 1, SIDE_DOWN);
+        }
+}
+
+/* ------------------------------------------------------------------------- */
+/* benchmark                                                                 */
+/* ------------------------------------------------------------------------- */
+/** Generate one maze with every algorithm and report throughput. */
+void MazeGenerator::benchmark(Grid& grid, std::ostream& out)
+{
+    const MazeAlgorithm saved = algorithm;
+    const double cells = static_cast<double>(grid.cellCount());
+
+    out << "Maze generation on " << grid.width << "x" << grid.height << " grid\n";
+    for (int i = 0; i < MAZE_ALGORITHM_COUNT; ++i)
+    {
+        algorithm = static_cast<MazeAlgorithm>(i);
+        auto t0 = std::chrono::steady_clock::now();
+        generate(grid, grid.width / 2, grid.height / 2);
+        auto t1 = std::chrono::steady_clock::now();
+
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        out << "  " << mazeAlgorithmName(algorithm) << ": " << ms << " ms, "
+            << (ms > 0.0 ? cells / (ms * 1000.0) : 0.0) << " Mcells/s";
+        if (grid.width > MAZE_TILE_COLS || grid.height > MAZE_TILE_ROWS)
+            out << " (" << threads << (threads > 1 ? " threads" : " thread") << ", tiled)";
+        out << "\n";
+    }
+    algorithm = saved;
+}
@@ -12,21 +12,26 @@
 // /*      col →  (x)                                                             */
 // /*      row ↓  (y)                                                             */
 // /*                                                                            */
-// /*      GRID_WIDTH   : number of columns (declared in mazeHelper.h)           */
-// /*      GRID_HEIGHT  : number of rows     (declared in mazeHelper.h)          */
+// /*      grid.width   : number of columns (runtime, see struct Grid)           */
+// /*      grid.height  : number of rows     (runtime, see struct Grid)          */
 // /*      NODE_SIZE    : side length of a single cell in pixels                 */
 // /*                                                                            */
 // /*  Public types (declared in mazeHelper.h)                                   */
 // /*  ------------------------------------------------------------------------  */
+// /*      struct Grid                                                           */
+// /*      {                                                                     */
+// /*          openRight, openDown, visited   // one bit per cell each           */
+// /*          ...                                                               */
+// /*      };                                                                    */
 // /*      struct Node                                                           */
 // /*      {                                                                     */
-// /*          bool  walls[4];      // TOP, RIGHT, DOWN, LEFT                    */
+// /*          bool  walls[4];      // RIGHT, DOWN, LEFT, TOP (decoded view)     */
 // /*          ...                                                               */
 // /*      };                                                                    */
 // /*      struct Wall                                                           */
 // /*      {                                                                     */
-// /*          Node* a;                    first  node of an edge                  */
-// /*          Node* b;                   second node of an edge                  */                                            */
+// /*          int cell1;                  first  cell of an edge                */
+// /*          int cell2;                 second cell of an edge                 */
 // /******************************************************************************/
 
 #include <SFML/Graphics.hpp>
@@ -35,11 +40,78 @@
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <algorithm>           // std::clamp
+#include <atomic>              // Grid revision counter
 
 // int FINISH_COL; // finish line column
 // int FINISH_ROW; // finish line row
-int FINISH_COL = GRID_WIDTH - 1;
-int FINISH_ROW = GRID_HEIGHT - 1;
+int FINISH_COL = DEFAULT_GRID_WIDTH - 1;   // main() re-rolls it for the real grid
+int FINISH_ROW = DEFAULT_GRID_HEIGHT - 1;
+
+
+/* ------------------------------------------------------------------------- */
+/* Grid                                                                      */
+/* ------------------------------------------------------------------------- */
+/** Allocate a width×height grid on the heap with every wall standing.
+ *  Out-of-range sizes are clamped to [1, MAX_GRID_DIM] with a warning.
+ */
+Grid::Grid(int w, int h)
+{
+    if (w < 1 || w > MAX_GRID_DIM || h < 1 || h > MAX_GRID_DIM)
+    {
+        std::cerr << "Grid size " << w << "x" << h << " out of range, clamping to [1,"
+                  << MAX_GRID_DIM << "]\n";
+        w = std::clamp(w, 1, MAX_GRID_DIM);
+        h = std::clamp(h, 1, MAX_GRID_DIM);
+    }
+    width  = w;
+    height = h;
+    stride = (w + 63) / 64;
+    reset();
+}
+
+/** Put every wall back up and forget which cells were visited. */
+void Grid::reset()
+{
+    const std::size_t words = static_cast<std::size_t>(height) * stride;
+    openRight.assign(words, 0);
+    openDown.assign(words, 0);
+    visited.assign(words, 0);
+    touch();
+}
+
+/** Revisions come from one process-wide counter, so two grids never share
+ *  one and a cache keyed on the revision alone cannot confuse them.
+ */
+void Grid::touch()
+{
+    static std::atomic<std::uint64_t> counter{0};
+    revision = ++counter;
+}
+
+/** Clear the bit that stores the wall on `side` of (col,row).
+ *  LEFT/TOP walls are owned by the neighbour, border walls stay closed.
+ */
+void Grid::openWall(int col, int row, int side)
+{
+    if (side == SIDE_LEFT)  { if (col == 0) return; --col; side = SIDE_RIGHT; }
+    if (side == SIDE_TOP)   { if (row == 0) return; --row; side = SIDE_DOWN;  }
+    if (side == SIDE_RIGHT && col + 1 >= width)  return;
+    if (side == SIDE_DOWN  && row + 1 >= height) return;
+
+    std::vector<std::uint64_t>& plane = (side == SIDE_RIGHT) ? openRight : openDown;
+    plane[row * stride + (col >> 6)] |= std::uint64_t{1} << (col & 63);
+}
+
+/** Decode the four walls and the visited flag of (col,row). */
+Node Grid::node(int col, int row) const
+{
+    Node n;
+    for (int side = 0; side < 4; ++side)
+        n.walls[side] = hasWall(col, row, side);
+    n.visited = isVisited(col, row);
+    return n;
+}
 
 
 
@@ -101,22 +173,22 @@ void drawFinish(sf::RenderWindow& window, int col, int row) {
  *  it is the caller’s responsibility to avoid duplicates if required.
  *
  *  @param wallVec   Vector that will receive newly discovered walls.
- *  @param nodeList  Flat array that stores the entire maze grid.
+ *  @param grid      The entire maze grid.
  *  @param col,row   Grid coordinates of the current cell.
  */
-void addWalls(std::vector<Wall>& wallVec, Node nodeList[], int col, int row)
+void addWalls(std::vector<Wall>& wallVec, Grid& grid, int col, int row)
 {
-    Node* base = &nodeList[col + row * GRID_WIDTH];
+    int base = grid.index(col, row);
 
     for (int side = 0; side < 4; ++side)
     {
         int nc = nextCol(col, side);
         int nr = nextRow(row, side);
 
-        if (indexIsValid(nc, nr))
+        if (indexIsValid(grid, nc, nr))
         {
             wallVec.push_back(
-                Wall{ base, &nodeList[nc + nr * GRID_WIDTH] }
+                Wall{ base, grid.index(nc, nr) }
             );
         }
     }
@@ -133,17 +205,17 @@ void addWalls(std::vector<Wall>& wallVec, Node nodeList[], int col, int row)
  *  adjacent cells, visually merging passages.
  *
  *  @param window    SFML render target.
- *  @param nodeList  Flat array that stores the entire maze grid.
+ *  @param grid      The entire maze grid.
  *  @param col,row   Grid coordinates of the cell to draw.
  *  @param isCurrent If true, the inner square is tinted red.
  */
 void drawNode(sf::RenderWindow& window,
-              Node          nodeList[],
-              int           col,
-              int           row,
-              bool          isCurrent)
+              const Grid&       grid,
+              int               col,
+              int               row,
+              bool              isCurrent)
 {
-    Node& n = nodeList[col + row * GRID_WIDTH];
+    const Node n = grid.node(col, row);
 
     /* Only render interior if at least one wall has been removed        */
     if (!(n.walls[0] && n.walls[1] && n.walls[2] && n.walls[3]))
@@ -218,17 +290,17 @@ void drawNode(sf::RenderWindow& window,
  *  `drawNode` for every cell.
  *
  *  @param window    SFML render target.
- *  @param nodeList  Flat array with GRID_WIDTH*GRID_HEIGHT nodes.
+ *  @param grid      Maze grid with width*height nodes.
  *  @param curCol,row Coordinates of the “current” cell (highlighted red).
  */
 void drawMaze(sf::RenderWindow& window,
-              Node          nodeList[],
-              int           curCol,
-              int           curRow)
+              const Grid&       grid,
+              int               curCol,
+              int               curRow)
 {
-    for (int r = 0; r < GRID_HEIGHT; ++r)
-        for (int c = 0; c < GRID_WIDTH; ++c)
-            drawNode(window, nodeList, c, r, (c == curCol && r == curRow));
+    for (int r = 0; r < grid.height; ++r)
+        for (int c = 0; c < grid.width; ++c)
+            drawNode(window, grid, c, r, (c == curCol && r == curRow));
 }
 
 /* ------------------------------------------------------------------------- */
@@ -236,10 +308,10 @@ void drawMaze(sf::RenderWindow& window,
 /* ------------------------------------------------------------------------- */
 
 /** Check whether (col,row) lies inside the grid. */
-bool indexIsValid(int col, int row)
+bool indexIsValid(const Grid& grid, int col, int row)
 {
-    return col >= 0 && col < GRID_WIDTH &&
-           row >= 0 && row < GRID_HEIGHT;
+    return col >= 0 && col < grid.width &&
+           row >= 0 && row < grid.height;
 }
 
 /** Compute neighbour column from a side constant. */
@@ -261,13 +333,13 @@ int nextRow(int cur_row, int side)
 /** Given two node indices, return which side of *idx1* touches *idx2*.
  *  Returns ‑1 when the nodes are not orthogonally adjacent.
  */
-int connectingSide(int idx1, int idx2)
+int connectingSide(const Grid& grid, int idx1, int idx2)
 {
     int diff = idx2 - idx1;
-    if (diff ==  1)          return SIDE_RIGHT;
-    if (diff == -1)          return SIDE_LEFT;
-    if (diff ==  GRID_WIDTH) return SIDE_DOWN;
-    if (diff == -GRID_WIDTH) return SIDE_TOP;
+    if (diff ==  1)           return SIDE_RIGHT;
+    if (diff == -1)           return SIDE_LEFT;
+    if (diff ==  grid.width)  return SIDE_DOWN;
+    if (diff == -grid.width)  return SIDE_TOP;
     return -1;    // nodes are not neighbours
 }
 
@@ -276,21 +348,18 @@ int connectingSide(int idx1, int idx2)
 /* ------------------------------------------------------------------------- */
 /** Knock down the common wall between two adjacent cells.
  *
- *  The function first determines the relative position of *n2* with respect
- *  to *n1*, clears the wall flag on both nodes, and yields a continuous
- *  passage.
+ *  The function first determines the relative position of *idx2* with
+ *  respect to *idx1* and clears the single bit both cells share, which
+ *  yields a continuous passage.
  *
- *  @param nodeList Global node array (needed to compute indices).
- *  @param n1,n2    Pointers to the two cells that will be joined.
+ *  @param grid      Maze grid.
+ *  @param idx1,idx2 Flat indices of the two cells that will be joined.
  */
-void joinNodes(Node nodeList[], Node* n1, Node* n2)
+void joinNodes(Grid& grid, int idx1, int idx2)
 {
-    int i1   = static_cast<int>(n1 - nodeList);
-    int i2   = static_cast<int>(n2 - nodeList);
-    int side = connectingSide(i1, i2);
+    int side = connectingSide(grid, idx1, idx2);
 
     if (side < 0) return;            // not adjacent – nothing to do
 
-    n1->walls[side]           = false;          // remove wall from n1
-    n2->walls[(side + 2) % 4] = false;          // remove opposite wall
+    grid.openWall(idx1 % grid.width, idx1 / grid.width, side); // shared bit
 }
@@ -0,0 +1,70 @@
+// =============================================================================
+// mazeStream.cpp — Endless row-by-row maze (streaming Eller)
+//
+// The view Grid is a sliding window over an infinite Eller maze.  Only the
+// Eller set labels of the newest row and that row's pending DOWN walls are
+// kept besides the view itself.
+// =============================================================================
+
+#include "../include/mazeStream.hpp"
+#include <algorithm>           // std::copy, std::fill
+#include "../include/rng.hpp"  // threadRng (stream seed)
+
+/* ------------------------------------------------------------------------- */
+/* begin                                                                     */
+/* ------------------------------------------------------------------------- */
+void MazeStream::begin(Grid& view)
+{
+    view.reset();
+    Rng& rng = threadRng();
+    eller.begin(view.width, (static_cast<std::uint64_t>(rng()) << 32) | rng());
+    pendingDown.assign(view.stride, 0);
+    emitted = 0;
+    rows    = view.height;
+
+    for (int r = 0; r < rows; ++r)
+    {
+        if (r > 0)                           // row above may now go down
+            std::copy(pendingDown.begin(), pendingDown.end(),
+                      view.openDown.begin() + static_cast<std::ptrdiff_t>(r - 1) * view.stride);
+        emitRow(view, r);
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* scroll                                                                    */
+/* ------------------------------------------------------------------------- */
+/** Shift the three bitplanes up by one row, restore the DOWN walls of the
+ *  old bottom row (its successor now exists) and carve a new bottom row.
+ */
+void MazeStream::scroll(Grid& view)
+{
+    if (rows == 0) return;
+
+    const std::ptrdiff_t s = view.stride;
+    for (std::vector<std::uint64_t>* plane : { &view.openRight, &view.openDown, &view.visited })
+    {
+        std::copy(plane->begin() + s, plane->end(), plane->begin());
+        std::fill(plane->end() - s, plane->end(), 0);
+    }
+
+    if (rows > 1)
+        std::copy(pendingDown.begin(), pendingDown.end(),
+                  view.openDown.begin() + static_cast<std::ptrdiff_t>(rows - 2) * s);
+    emitRow(view, rows - 1);
+    view.touch();
+}
+
+/* ------------------------------------------------------------------------- */
+/* emitRow                                                                   */
+/* ------------------------------------------------------------------------- */
+void MazeStream::emitRow(Grid& view, int row)
+{
+    const std::size_t w = static_cast<std::size_t>(row) * view.stride;
+
+    std::fill(pendingDown.begin(), pendingDown.end(), 0);
+    eller.nextRow(&view.openRight[w], pendingDown.data(), false);
+    for (int c = 0; c < view.width; ++c)
+        view.markVisited(c, row);
+    ++emitted;
+}
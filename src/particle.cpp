@@ -10,17 +10,19 @@
 //
 // The accompanying declarations and grid helpers live in:
 //   • particle.hpp   — class/struct definitions
-//   • mazeHelper.h   — grid constants (GRID_WIDTH, GRID_HEIGHT, NODE_SIZE),
-//                      Node struct, and helper functions nextCol/nextRow/
-//                      indexIsValid.
+//   • mazeHelper.h   — NODE_SIZE, Node/Grid structs, and helper functions
+//                      nextCol/nextRow/indexIsValid.
 //
 // © <2025> <Victor Emanuel> — MIT License
 // =============================================================================
 
 #include "../include/particle.hpp"
-#include "../include/mazeHelper.hpp"       // GRID_* constants & Node helpers
+#include "../include/mazeHelper.hpp"       // Grid, Node & helpers
+#include "../include/quantumKernels.hpp"   // evolve stencil and SIMD kernels
+#include "../include/fastForward.hpp"      // multi-step strategies
+#include "../include/collision.hpp"        // sweepCircle (wall collisions)
 #include <SFML/Graphics.hpp>
-#include <algorithm>           // std::copy (used in QuantumParticle::evolve)
+#include <algorithm>           // std::fill/std::copy/std::max
 #include <iostream>
 
 
@@ -41,52 +43,13 @@ void PlayerParticle::draw(sf::RenderWindow& window) const
 /*Function to determinates if is possible to the classical is in the ritgh place*/
 
 
-void PlayerParticle::update(float dt, Node nodeList[]){
+void PlayerParticle::update(float dt, const Grid& grid){
     // integrate
     velocity += acceleration * dt;
-    sf::Vector2f nextPos = position + velocity * dt;
 
-    // current cell of the CENTER
-    int col = static_cast<int>(position.x / NODE_SIZE);
-    int row = static_cast<int>(position.y / NODE_SIZE);
-    if (col < 0 || col >= GRID_WIDTH || row < 0 || row >= GRID_HEIGHT)
-        return;
-
-    const float r = NODE_SIZE * 0.2f; // same radius used to draw
-    const int idx = col + row * GRID_WIDTH;
-    const Node& n = nodeList[idx];
-
-    // X axis: clamp to the wall boundary using the radius
-    if (velocity.x > 0.f && n.walls[SIDE_RIGHT]) {
-        float maxX = (col + 1) * NODE_SIZE - r;   // inside face of right wall
-        if (nextPos.x > maxX) {
-            nextPos.x = maxX;
-            velocity.x = 0.f;
-        }
-    } else if (velocity.x < 0.f && n.walls[SIDE_LEFT]) {
-        float minX = col * NODE_SIZE + r;         // inside face of left wall
-        if (nextPos.x < minX) {
-            nextPos.x = minX;
-            velocity.x = 0.f;
-        }
-    }
-
-    // Y axis: clamp to the wall boundary using the radius
-    if (velocity.y > 0.f && n.walls[SIDE_DOWN]) {
-        float maxY = (row + 1) * NODE_SIZE - r;   // inside face of bottom wall
-        if (nextPos.y > maxY) {
-            nextPos.y = maxY;
-            velocity.y = 0.f;
-        }
-    } else if (velocity.y < 0.f && n.walls[SIDE_TOP]) {
-        float minY = row * NODE_SIZE + r;         // inside face of top wall
-        if (nextPos.y < minY) {
-            nextPos.y = minY;
-            velocity.y = 0.f;
-        }
-    }
-
-    position = nextPos;
+    // swept move of the disc through every cell it crosses; walls stop the
+    // blocked component and the player slides along them
+    sweepCircle(evolveStencil(grid), position, velocity, dt, radius(), WallResponse::Slide);
 }
 
 /**
@@ -94,21 +57,20 @@ void PlayerParticle::update(float dt, Node nodeList[]){
  *
  * @param newCol  New column index in the grid.
  * @param newRow  New row index in the grid.
- * @param nodeList  Flat array of Node objects representing the maze layout.
+ * @param grid    Maze grid describing the layout.
  */
 void PlayerParticle::setPosition(int newCol,
     int newRow,
-    Node nodeList[])
+    const Grid& grid)
 {
     // 1) Bounds check
-    if (!indexIsValid(newCol, newRow)) {
+    if (!indexIsValid(grid, newCol, newRow)) {
     std::cout << "Invalid cell (" 
     << newCol << "," << newRow << ")\n";
     return;
     }
 
     // 2) Which side?
-    int oldIdx = col + row * GRID_WIDTH;
     int side = -1;
     if      (newCol == col + 1 && newRow == row)      side = SIDE_RIGHT;
     else if (newCol == col - 1 && newRow == row)      side = SIDE_LEFT;
@@ -116,7 +78,7 @@ void PlayerParticle::setPosition(int newCol,
     else if (newRow == row - 1 && newCol == col)      side = SIDE_TOP;
 
     // 3) Blocked by wall?  Bounce
-    if (side >= 0 && nodeList[oldIdx].walls[side]) {
+    if (side >= 0 && grid.hasWall(col, row, side)) {
     if (side == SIDE_LEFT || side == SIDE_RIGHT)
     velocity.x = -velocity.x;
     else
@@ -137,6 +99,22 @@ void PlayerParticle::setPosition(int newCol,
 }
 
 
+/**
+ * @brief Shifts the particle up with a scrolling MazeStream view.
+ *
+ * @param rows  Number of rows the view scrolled.
+ */
+void PlayerParticle::scroll(int rows)
+{
+    position.y -= rows * NODE_SIZE;
+    row        -= rows;
+    if (row < 0) {                           // pushed off the top edge
+        row = 0;
+        position.y = std::max(position.y, radius());
+    }
+}
+
+
 // ─────────────────────────────────────────────────────────────────────────────
 // ClassicalParticle — methods
 // ─────────────────────────────────────────────────────────────────────────────
@@ -146,7 +124,7 @@ void PlayerParticle::setPosition(int newCol,
  *
  * @param dt   Elapsed time in **seconds** since last frame.
  */
-// void ClassicalParticle::update(float dt, Node nodeList[])
+// void ClassicalParticle::update(float dt, const Grid& grid)
 // {
 //     velocity += acceleration * dt;
 //     position += velocity * dt;
@@ -175,57 +153,27 @@ void ClassicalParticle::draw(sf::RenderWindow& window) const
 
 /*Function to determinates if is possible to the classical is in the ritgh place*/
 
-void ClassicalParticle::update(float dt, Node nodeList[])
+void ClassicalParticle::update(float dt, const Grid& grid)
 {
     // 1) integrate acceleration → velocity
     velocity += acceleration * dt;
-    
-
-    // 2) propose new continuous position
-    sf::Vector2f nextPos = position + velocity * dt;
-
-    // 3) figure out which cell we’re in, before and after
-    int oldCol = static_cast<int>(position.x / NODE_SIZE);
-    int oldRow = static_cast<int>(position.y / NODE_SIZE);
-    int newCol = static_cast<int>(nextPos.x  / NODE_SIZE);
-    int newRow = static_cast<int>(nextPos.y  / NODE_SIZE);
-
-    // 4) handle X­axis crossing
-    if (newCol != oldCol) {
-        // which wall would we cross?
-        int side = (newCol > oldCol) ? SIDE_RIGHT : SIDE_LEFT;
-        // if there’s a wall there, bounce and cancel the X move
-        if (nodeList[oldCol + oldRow*GRID_WIDTH].walls[side]) {
-            velocity.x = -velocity.x;
-            nextPos.x = position.x;
-        }
-    }
 
-    // 5) handle Y­axis crossing
-    if (newRow != oldRow) {
-        int side = (newRow > oldRow) ? SIDE_DOWN : SIDE_TOP;
-        if (nodeList[oldCol + oldRow*GRID_WIDTH].walls[side]) {
-            velocity.y = -velocity.y;
-            nextPos.y = position.y;
-        }
-    }
-
-    // 6) commit the (possibly corrected) position
-    position = nextPos;
+    // 2) sweep the disc along velocity·dt cell by cell (DDA), bouncing off
+    //    every wall on the way, so no step length can tunnel through one
+    sweepCircle(evolveStencil(grid), position, velocity, dt, radius(), WallResponse::Bounce);
 }
 void ClassicalParticle::setPosition(int newCol,
     int newRow,
-    Node nodeList[])
+    const Grid& grid)
 {
     // 1) Bounds check
-    if (!indexIsValid(newCol, newRow)) {
+    if (!indexIsValid(grid, newCol, newRow)) {
     std::cout << "Invalid cell (" 
     << newCol << "," << newRow << ")\n";
     return;
     }
 
     // 2) Which side?
-    int oldIdx = col + row * GRID_WIDTH;
     int side = -1;
     if      (newCol == col + 1 && newRow == row)      side = SIDE_RIGHT;
     else if (newCol == col - 1 && newRow == row)      side = SIDE_LEFT;
@@ -233,7 +181,7 @@ void ClassicalParticle::setPosition(int newCol,
     else if (newRow == row - 1 && newCol == col)      side = SIDE_TOP;
 
     // 3) Blocked by wall?  Bounce
-    if (side >= 0 && nodeList[oldIdx].walls[side]) {
+    if (side >= 0 && grid.hasWall(col, row, side)) {
     if (side == SIDE_LEFT || side == SIDE_RIGHT)
     velocity.x = -velocity.x;
     else
@@ -258,50 +206,161 @@ void ClassicalParticle::setPosition(int newCol,
 }
 
 
+/**
+ * @brief Shifts the particle up with a scrolling MazeStream view.
+ *
+ * @param rows  Number of rows the view scrolled.
+ */
+void ClassicalParticle::scroll(int rows)
+{
+    position.y -= rows * NODE_SIZE;
+    row        -= rows;
+    if (row < 0) {                           // pushed off the top edge
+        row = 0;
+        position.y = std::max(position.y, radius());
+    }
+}
+
+
 // ─────────────────────────────────────────────────────────────────────────────
 // QuantumParticle — methods
 // ─────────────────────────────────────────────────────────────────────────────
 
-/**
- * @brief Resets the probability array to a uniform distribution.
- */
-
 //define the number of particles in the maze
 // std::vector<QuantumParticle*> particles; //vector to store the particles
 
 
-void QuantumParticle::addQuantumParticle(std::vector<QuantumParticle*>& out, int numParticles, Node* nodeList) {
-    for (int i = 0; i < numParticles; ++i) {
-        // QuantumParticle* particle = new QuantumParticle; //creating the bot 
-        auto*p =new QuantumParticle; //creating the bot
-        // particle->position = sf::Vector2f(0.f, 0.f); // Initial position
-        // particle->col = std::rand() % GRID_WIDTH; // Random column
-        // particle->row = std::rand() % GRID_HEIGHT; // Random row
-        // particle->color = sf::Color(std::rand() , std::rand() , std::rand()); // Default color
-        // particle->initialize(nodeList); // Initialize the probability array
-        // particles.push_back(particle);
-
-        p->col = std::rand() % GRID_WIDTH; // Random column
-        p->row = std::rand() % GRID_HEIGHT; // Random row
-        p->color = sf::Color(std::rand() , std::rand() , std::rand()); // Default color
-        p->initialize(nodeList); // Initialize the probability array
-        out.push_back(p); // Add the particle to the vector
+/** Drops the float field and its step target: while packed, the planes
+ *  are the only copy of the state. */
+static void releaseFloats(QuantumParticle& q)
+{
+    std::vector<float>().swap(q.probability);
+    std::vector<float>().swap(q.scratch);
+}
 
+static void releasePacked(QuantumParticle& q)
+{
+    q.packed = PackedField();
+    q.packedScratch = PackedField();
+}
 
-    }
-    std::cout << "Quantum particles generated "<<numParticles << "!\n";
+/** Reads a packed field a range at a time, for the block sampler */
+static FieldReader packedReader(const PackedField& field)
+{
+    return [&field](int begin, int end, float* out) { field.unpack(out, begin, end); };
 }
-void QuantumParticle::initialize(Node* nodeList) //the probability array is initialized to a uniform distribution
+
+/**
+ * @brief Resets the probability array to a uniform distribution.
+ */
+void QuantumParticle::initialize(const Grid& grid) //the probability array is initialized to a uniform distribution
 {
     // addQuantumParticle(particles, 100, nodeList);
     // std::cout << "Quantum particles generated "<<numParticles << "!\n";
-    float uniform = 1.0f / (GRID_WIDTH * GRID_HEIGHT);
-    for (int i = 0; i < GRID_WIDTH * GRID_HEIGHT; ++i){
-        probability[i] = uniform;
+    const int cells = grid.cellCount();
+    float uniform = 1.0f / cells;
+    sparse = false;                          // full support, dense kernel
+    coherent = false;
+    pendingSteps = 0;
+    active.reset(0);
+    nextActive.reset(0);
+    if (isPacked())
+    {
+        releaseFloats(*this);
+        packed.fill(cells, precision, uniform);
+        packedScratch.resizeLike(packed);
+        return;
+    }
+    releasePacked(*this);
+    probability.assign(cells, uniform);
+    scratch.assign(cells, 0.0f);
+    if (pool && pool->firstTouch)            // pages onto the nodes that evolve them
+    {
+        firstTouchFill(probability.data(), cells, grid.width, uniform, *pool);
+        firstTouchFill(scratch.data(), cells, grid.width, 0.0f, *pool);
     }
         // std::cout << "Quantum particle initialized with uniform distribution.\n";
 }
 
+void QuantumParticle::initializeAt(const Grid& grid, int startCol, int startRow)
+{
+    const int cells = grid.cellCount();
+    const int start = grid.index(std::clamp(startCol, 0, grid.width  - 1),
+                                 std::clamp(startRow, 0, grid.height - 1));
+    coherent = false;
+    pendingSteps = 0;
+    if (isPacked())
+    {
+        // packed fields always step densely: no active set
+        releaseFloats(*this);
+        packed.fill(cells, precision, 0.0f);
+        packed.set(start, 1.0f);
+        packedScratch.resizeLike(packed);
+        sparse = false;
+        active.reset(0);
+        nextActive.reset(0);
+        return;
+    }
+    releasePacked(*this);
+    probability.assign(cells, 0.0f);
+    scratch.assign(cells, 0.0f);
+    if (pool && pool->firstTouch)            // pages onto the nodes that evolve them
+    {
+        firstTouchFill(probability.data(), cells, grid.width, 0.0f, *pool);
+        firstTouchFill(scratch.data(), cells, grid.width, 0.0f, *pool);
+    }
+    probability[start] = 1.0f;
+    sparse = true;
+    active.reset(cells);
+    nextActive.reset(cells);
+    active.insert(start);
+}
+
+void QuantumParticle::initializeCoherent(const Grid& grid, int startCol, int startRow, QuantumCoin coin)
+{
+    initialize(grid);
+    releasePacked(*this);                    // the walk keeps float amplitudes
+    coherent  = true;
+    walk.coin = coin;
+    walk.initializeAt(grid, startCol, startRow);
+    walk.probability(probability);
+}
+
+void QuantumParticle::setPrecision(const Grid& grid, FieldPrecision newPrecision)
+{
+    settle(grid);
+    if (isPacked())
+    {
+        // a float copy is the hand-over between two storages
+        probability.resize(packed.cells);
+        packed.unpack(probability.data());
+        releasePacked(*this);
+    }
+    precision = newPrecision;
+    if (!isPacked())
+    {
+        scratch.resize(probability.size());  // zero unless sparse, which it only is when it was float
+        return;
+    }
+    sparse = false;
+    active.reset(0);
+    nextActive.reset(0);
+    packed.pack(probability.data(), static_cast<int>(probability.size()), precision);
+    packedScratch.resizeLike(packed);
+    releaseFloats(*this);
+}
+
+const std::vector<float>& QuantumParticle::field(const Grid& grid)
+{
+    settle(grid);
+    if (isPacked())
+    {
+        probability.resize(packed.cells);
+        packed.unpack(probability.data());
+    }
+    return probability;
+}
+
 
 /**
  * @brief Advances the quantum particle's wavefunction using a discrete quantum walk.
@@ -313,51 +372,98 @@ void QuantumParticle::initialize(Node* nodeList) //the probability array is init
  *
  * The result is a new probability field that replaces the current one.
  *
- * @param nodeList A flat array of `Node` objects representing the maze grid.
- *                 Each node contains wall information that determines valid paths
- *                 for the quantum walk.
+ * @param grid     The maze grid. Each node contains wall information that
+ *                 determines valid paths for the quantum walk.
  */
 
-void QuantumParticle::evolve(Node nodeList[]) 
+void QuantumParticle::evolve(const Grid& grid) 
 /*the probability mass in each cell flows equally to all
 neighbouring cells that are reachable (i.e., the corresponding wall is open)*/
 {
-    float next[GRID_WIDTH * GRID_HEIGHT] = {0.0f}; // next probability field
+    if (pendingSteps > 0)
+        settle(grid);                        // queued steps come first
+    if (coherent)
+    {
+        walk.step(grid);                     // coin + shift on the amplitudes
+        walk.probability(probability);
+        return;
+    }
+    if (fieldCells() != grid.cellCount())
+        initialize(grid);                    // grid was resized under us
 
-    for (int r = 0; r < GRID_HEIGHT; ++r)
+    if (isPacked())
     {
-        for (int c = 0; c < GRID_WIDTH; ++c)
+        evolvePacked(evolveStencil(grid), packed, packedScratch);
+        std::swap(packed, packedScratch);
+        if (!probability.empty())
+            std::vector<float>().swap(probability);   // a field() copy is stale now
+        return;
+    }
+
+    // gather-form step over the cached per-maze stencil (SIMD when available)
+    const EvolveStencil& stencil = evolveStencil(grid);
+    scratch.resize(probability.size());
+    if (sparse)
+    {
+        // scratch is all zero here; only the new support gets written
+        evolveSparse(stencil, probability.data(), scratch.data(), active, nextActive);
+        for (int cell : active.cells)
+            probability[cell] = 0.0f;        // becomes the zeroed scratch after the swap
+        active.clear();
+        std::swap(active, nextActive);
+
+        if (active.size() > QUANTUM_SPARSE_LIMIT * grid.cellCount())
         {
-            int idx = c + r * GRID_WIDTH;
-            float p = probability[idx];
-            if (p == 0) continue;        // skip zero‑probability cells
+            sparse = false;                  // support too wide, go dense
+            active.reset(0);
+            nextActive.reset(0);
+        }
+    }
+    else if (pool && pool->size() > 1 && grid.cellCount() >= QUANTUM_PARALLEL_MIN_CELLS)
+        evolveKernelParallel(stencil, probability.data(), scratch.data(), *pool);
+    else
+        evolveKernel(stencil, probability.data(), scratch.data());
+
+    // swap into the member array (no copy)
+    probability.swap(scratch);
+}
 
-            Node &n = nodeList[idx];
+void QuantumParticle::settle(const Grid& grid)
+{
+    if (pendingSteps > 0)
+    {
+        const long long steps = pendingSteps;
+        pendingSteps = 0;                    // evolve() inside fastForward must not recurse
+        fastForward(grid, steps);
+    }
+}
 
-            // count open exits (walls == false)
-            int count = 0;
-            for (int s = 0; s < 4; ++s)
-                if (!n.walls[s]) ++count;
+void QuantumParticle::fastForward(const Grid& grid, long long steps)
+{
+    if (coherent)
+    {
+        // unitary evolution has no limit to jump to: step, measure once
+        for (; steps > 0; --steps)
+            walk.step(grid);
+        walk.probability(probability);
+        return;
+    }
+    if (fieldCells() != grid.cellCount())
+        initialize(grid);
 
-            // distribute probability equally among open exits
-            for (int s = 0; s < 4; ++s)
-            {
-                if (!n.walls[s])
-                {
-                    int nc = nextCol(c, s);
-                    int nr = nextRow(r, s);
-                    if (indexIsValid(nc, nr))
-                    {
-                        int ni = nc + nr * GRID_WIDTH;
-                        next[ni] += p / count;
-                    }
-                }
-            }
-        }
+    if (isPacked())
+    {
+        // the multi-step strategies work on floats: step the packed field
+        for (; steps > 0; --steps)
+            evolve(grid);
+        return;
     }
 
-    // copy back into member array
-    std::copy(std::begin(next), std::end(next), std::begin(probability));
+    // a localized field is cheapest to step sparsely until it spreads
+    for (; steps > 0 && sparse; --steps)
+        evolve(grid);
+
+    fastForwardField(grid, probability, scratch, steps, pool);
 }
 
 /**
@@ -367,30 +473,57 @@ neighbouring cells that are reachable (i.e., the corresponding wall is open)*/
  * cumulative probability exceeds r. The particle then acquires definite cell
  * coordinates `(col,row)`.
  */
-void QuantumParticle::collapse()
+void QuantumParticle::collapse(const Grid& grid)
 {
-    // Step 1: Generate a random number in the range [0, 1)
-    float r = static_cast<float>(rand()) / RAND_MAX;
+    settle(grid);                            // the measurement needs the current field
+
+    // Step 1: Generate a random number in the range [0, 1), 53 bits so
+    // every cell of a grid above 2^24 cells can be hit
+    const double r = rng.uniformDouble();
+
+    // Step 2: prefix sums of the field (double, so they reach the total);
+    // a packed field keeps one per block and is decoded block by block
+    const bool fromPacked = isPacked();
+    if (fromPacked ? !sampler.buildBlocks(packed.cells, packedReader(packed))
+                   : !sampler.build(probability.data(), static_cast<int>(probability.size())))
+        return;                              // no mass: nothing to measure
+
+    // Step 3: Collapse the wavefunction at the first index where the cumulative
+    // probability exceeds r (binary search)
+    const int i = fromPacked ? sampler.sample(r, packedReader(packed)) : sampler.sample(r);
+    col = i % grid.width;
+    row = i / grid.width;
+    collapsed = true;
+}
 
-    // Step 2: Iterate through the probability field, accumulating probability
-    float sum = 0.0f;
-    for (int i = 0; i < GRID_WIDTH * GRID_HEIGHT; ++i)
+/**
+ * @brief Draws a batch of measurements without collapsing the particle.
+ *
+ * The counter-based stream is keyed by this particle's Rng stream, so
+ * particles on different streams never share draws.
+ */
+void QuantumParticle::measure(const Grid& grid, int count, std::vector<int>& cells)
+{
+    settle(grid);
+    cells.clear();
+    if (count <= 0) return;
+    const std::uint64_t stream = mix64(RNG_STREAM_QUANTUM) ^ rng.inc;
+    if (isPacked())
     {
-        sum += probability[i];
-
-        // Step 3: Collapse the wavefunction at the first index where the cumulative
-        // probability exceeds the random number r
-        if (r < sum)
-        {
-            // Compute the corresponding cell coordinates (col, row)
-            col = i % GRID_WIDTH;
-            row = i / GRID_WIDTH;
-
-            // Mark the particle as collapsed
-            collapsed = true;
-            break;
-        }
+        // no per-cell tables: block prefix sums, each block decoded once per batch
+        if (!sampler.buildBlocks(packed.cells, packedReader(packed)))
+            return;
+        cells.resize(count);
+        sampler.sampleBatch(masterSeed(), stream, measurements, count, cells.data(), packedReader(packed));
+    }
+    else
+    {
+        if (!sampler.buildAlias(probability.data(), static_cast<int>(probability.size())))
+            return;
+        cells.resize(count);
+        sampler.sampleBatch(masterSeed(), stream, measurements, count, cells.data());
     }
+    measurements += count;
 }
 
 /**
@@ -401,19 +534,26 @@ void QuantumParticle::collapse()
  *  • **Collapsed**     → Draw a solid magenta circle at the selected cell.
  *
  * @param window SFML render target.
+ * @param grid   Maze grid the field lives on.
  */
-void QuantumParticle::draw(sf::RenderWindow& window) const
+void QuantumParticle::draw(sf::RenderWindow& window, const Grid& grid)
 {
     // Case 1: Particle has not yet collapsed
     if (!collapsed)
     {
+        settle(grid);                        // the blobs show the current field
+        if (fieldCells() != grid.cellCount())
+            return;                          // not initialised for this grid
+        const bool fromPacked = isPacked();
+
         // Iterate over every cell in the grid
-        for (int r = 0; r < GRID_HEIGHT; ++r)
+        for (int r = 0; r < grid.height; ++r)
         {
-            for (int c = 0; c < GRID_WIDTH; ++c)
+            for (int c = 0; c < grid.width; ++c)
             {
                 // Get the probability at this cell
-                float p = probability[c + r * GRID_WIDTH];
+                const int i = grid.index(c, r);
+                float p = fromPacked ? packed.at(i) : probability[i];
 
                 // Only draw if probability is noticeable
                 if (p > 0.01f)
@@ -445,3 +585,52 @@ void QuantumParticle::draw(sf::RenderWindow& window) const
         window.draw(qblob);
     }
 }
+
+/**
+ * @brief Moves the probability field up with a scrolling MazeStream view.
+ */
+void QuantumParticle::scroll(int rows, const Grid& grid)
+{
+    if (coherent)
+    {
+        walk.scroll(rows, grid);
+        walk.probability(probability);
+        return;
+    }
+    const std::size_t shift = static_cast<std::size_t>(rows) * grid.width;
+    if (fieldCells() != grid.cellCount() ||
+        shift >= static_cast<std::size_t>(fieldCells()))
+    {
+        initialize(grid);
+        return;
+    }
+
+    sparse = false;                          // the support moved, track it densely
+    active.reset(0);
+    nextActive.reset(0);
+    if (isPacked())
+    {
+        // shift and renormalise in place, a chunk of floats at a time
+        std::vector<float>().swap(probability);   // a field() copy is stale now
+        packed.shiftDown(static_cast<int>(shift));
+        row -= rows;
+        const double sum = packed.sum();
+        if (sum <= 0.0) {
+            initialize(grid);                // everything scrolled away
+            return;
+        }
+        packed.scale(static_cast<float>(1.0 / sum));
+        return;
+    }
+    std::copy(probability.begin() + shift, probability.end(), probability.begin());
+    std::fill(probability.end() - shift, probability.end(), 0.0f);
+    row -= rows;
+
+    float sum = 0.0f;
+    for (float p : probability) sum += p;
+    if (sum <= 0.0f) {
+        initialize(grid);                    // everything scrolled away
+        return;
+    }
+    for (float& p : probability) p /= sum;
+}
@@ -0,0 +1,182 @@
+// =============================================================================
+// quantumEnsemble.cpp — N quantum walkers evolved as one cells×lanes matrix
+// =============================================================================
+
+#include "../include/quantumEnsemble.hpp"
+#include "../include/quantumKernels.hpp"  // evolveStencil, evolveEnsembleKernel
+#include <algorithm>                      // std::copy, std::fill
+#include <iostream>
+
+/* ------------------------------------------------------------------------- */
+/* initialize                                                                */
+/* ------------------------------------------------------------------------- */
+void QuantumEnsemble::initialize(const Grid& grid, int numWalkers)
+{
+    requested = std::max(0, numWalkers);
+    cells     = grid.cellCount();
+
+    // lanes that fit the budget, in whole SIMD groups
+    const std::size_t bytesPerLane = static_cast<std::size_t>(cells) * sizeof(float) * 2;
+    const std::size_t maxLanes     = QUANTUM_ENSEMBLE_MAX_BYTES / bytesPerLane
+                                     / QUANTUM_ENSEMBLE_ALIGN * QUANTUM_ENSEMBLE_ALIGN;
+    count = static_cast<int>(std::min<std::size_t>(requested, maxLanes));
+    if (count < requested)
+        std::cerr << "Quantum ensemble: " << requested << " walkers need more than "
+                  << (QUANTUM_ENSEMBLE_MAX_BYTES >> 20) << " MiB on this grid, running "
+                  << count << "\n";
+    lanes = (count + QUANTUM_ENSEMBLE_ALIGN - 1) / QUANTUM_ENSEMBLE_ALIGN * QUANTUM_ENSEMBLE_ALIGN;
+
+    const float uniform = 1.0f / cells;
+    probability.assign(static_cast<std::size_t>(cells) * lanes, 0.0f);
+    scratch.assign(probability.size(), 0.0f);
+    pendingSteps = 0;
+    for (int i = 0; i < cells; ++i)
+        std::fill_n(&probability[static_cast<std::size_t>(i) * lanes], count, uniform);
+
+    col.resize(count);
+    row.resize(count);
+    color.resize(count);
+    rng.resize(count);
+    for (int k = 0; k < count; ++k)
+    {
+        rng[k]   = makeRng(RNG_STREAM_QUANTUM, k + 1);   // own measurement stream per walker
+        col[k]   = rng[k].below(grid.width);
+        row[k]   = rng[k].below(grid.height);
+        color[k] = sf::Color(rng[k](), rng[k](), rng[k]());
+    }
+    std::cout << "Quantum ensemble of " << count << " walkers ready!\n";
+}
+
+/* ------------------------------------------------------------------------- */
+/* evolve                                                                    */
+/* ------------------------------------------------------------------------- */
+void QuantumEnsemble::evolve(const Grid& grid)
+{
+    if (pendingSteps > 0)
+        settle(grid);                        // queued steps come first
+    if (cells != grid.cellCount())
+        initialize(grid, requested);             // grid was resized under us
+    if (count == 0) return;
+
+    evolveEnsembleKernel(evolveStencil(grid), probability.data(), scratch.data(), lanes);
+    probability.swap(scratch);
+}
+
+/** The queued steps run back to back on one stencil lookup; nothing reads
+ *  the fields between them, so no measurement pass is spent per step. */
+void QuantumEnsemble::settle(const Grid& grid)
+{
+    if (pendingSteps <= 0) return;
+    long long steps = pendingSteps;
+    pendingSteps = 0;
+    if (cells != grid.cellCount())
+        initialize(grid, requested);             // grid was resized under us
+    if (count == 0) return;
+
+    const EvolveStencil& stencil = evolveStencil(grid);
+    for (; steps > 0; --steps)
+    {
+        evolveEnsembleKernel(stencil, probability.data(), scratch.data(), lanes);
+        probability.swap(scratch);
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* collapseAll                                                               */
+/* ------------------------------------------------------------------------- */
+/** Inverse-CDF sampling for all walkers at once, with the semantics of
+ *  FieldSampler: a first pass sums each lane's mass, a second advances a
+ *  cumulative sum per lane cell by cell until it passes u · mass.  Both
+ *  sums are double, so the CDF reaches the lane's mass on any grid size
+ *  instead of stalling short of it the way a float running sum does.  The
+ *  per-lane update is a branch-free select (no mispredicted branches).
+ */
+void QuantumEnsemble::collapseAll(const Grid& grid)
+{
+    settle(grid);                            // the measurement needs the current fields
+    if (cells != grid.cellCount() || count == 0) return;
+
+    std::vector<double> target(count), sum(count, 0.0);
+    std::vector<int>    hit(count, -1);          // first cell whose CDF passes target
+    std::vector<int>    last(count, -1);         // last cell with mass, if rounding falls short
+    for (int i = 0; i < cells; ++i)
+    {
+        const float* p = &probability[static_cast<std::size_t>(i) * lanes];
+        for (int k = 0; k < count; ++k)
+        {
+            sum[k] += p[k] > 0.0f ? p[k] : 0.0f;    // ignore rounding negatives
+            last[k] = p[k] > 0.0f ? i : last[k];
+        }
+    }
+    for (int k = 0; k < count; ++k)
+    {
+        target[k] = rng[k].uniformDouble() * sum[k];   // 53 bits: every cell reachable
+        sum[k]    = 0.0;
+    }
+
+    for (int i = 0; i < cells; ++i)
+    {
+        const float* p = &probability[static_cast<std::size_t>(i) * lanes];
+        for (int k = 0; k < count; ++k)
+        {
+            sum[k] += p[k] > 0.0f ? p[k] : 0.0f;
+            hit[k]  = (hit[k] < 0 && target[k] < sum[k]) ? i : hit[k];
+        }
+    }
+
+    for (int k = 0; k < count; ++k)
+    {
+        const int cell = hit[k] >= 0 ? hit[k] : last[k];   // u · mass rounded up to the mass
+        if (cell < 0) continue;                  // walker holds no mass
+        col[k] = cell % grid.width;
+        row[k] = cell / grid.width;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* scroll                                                                    */
+/* ------------------------------------------------------------------------- */
+void QuantumEnsemble::scroll(int rows, const Grid& grid)
+{
+    const std::size_t shift = static_cast<std::size_t>(rows) * grid.width * lanes;
+    if (cells != grid.cellCount() || (count > 0 && shift >= probability.size()))
+    {
+        initialize(grid, requested);
+        return;
+    }
+    if (count == 0) return;                  // nothing fits this grid
+
+    std::copy(probability.begin() + shift, probability.end(), probability.begin());
+    std::fill(probability.end() - shift, probability.end(), 0.0f);
+    for (int k = 0; k < count; ++k)
+        row[k] = std::max(0, row[k] - rows);
+
+    std::vector<float> sum(count, 0.0f);
+    for (int i = 0; i < cells; ++i)
+    {
+        const float* p = &probability[static_cast<std::size_t>(i) * lanes];
+        for (int k = 0; k < count; ++k) sum[k] += p[k];
+    }
+    const float uniform = 1.0f / cells;
+    for (int i = 0; i < cells; ++i)
+    {
+        float* p = &probability[static_cast<std::size_t>(i) * lanes];
+        for (int k = 0; k < count; ++k)
+            p[k] = sum[k] > 0.0f ? p[k] / sum[k] : uniform;   // emptied walker restarts uniform
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* draw                                                                      */
+/* ------------------------------------------------------------------------- */
+void QuantumEnsemble::draw(sf::RenderWindow& window) const
+{
+    sf::CircleShape dot(NODE_SIZE * 0.15f);
+    for (int k = 0; k < count; ++k)
+    {
+        dot.setFillColor(color[k]);
+        dot.setPosition(sf::Vector2f(col[k] * NODE_SIZE + NODE_SIZE * 0.35f,
+                                     row[k] * NODE_SIZE + NODE_SIZE * 0.35f));
+        window.draw(dot);
+    }
+}
@@ -0,0 +1,449 @@
+// =============================================================================
+// quantumKernels.cpp — Gather-form quantum-walk step, scalar and SIMD
+//
+// All kernels add the four neighbour contributions in the same order
+// (RIGHT, DOWN, LEFT, TOP) with separate multiply and add, and a closed side
+// adds an exact 0.  The SIMD kernels therefore reproduce the scalar one bit
+// for bit; they differ from the old scatter loop (p / k instead of
+// p * (1/k)) only by float rounding.
+//
+// The dense kernels work on a span [begin, end) of flat cells, reading a
+// buffer whose element 0 is cell `inBase` and writing one whose element 0 is
+// cell `outBase`; a full step is the span [0, cells) with both bases 0, and
+// temporal blocking runs spans over cache-sized row bands.  SIMD lanes cover
+// [width, cells - width) of the span: every neighbour load there stays inside
+// the grid, and row wrap-around at the left/right borders is harmless
+// because those sides are always closed.  The first and last rows and the
+// tails go through the scalar path.
+// =============================================================================
+
+#include "../include/quantumKernels.hpp"
+#include "../include/threadPool.hpp"     // evolveKernelParallel, parallel bands
+#include <algorithm>           // std::min, std::max, std::swap
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC fuses vector mul + add into FMA inside the AVX-512 functions, which
+// would break bit-exact agreement with the scalar kernels
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QUANTUM_KERNELS_X86 1
+#include <immintrin.h>         // AVX2 / AVX-512 intrinsics
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* EvolveStencil                                                             */
+/* ------------------------------------------------------------------------- */
+bool EvolveStencil::update(const Grid& grid)
+{
+    if (revision == grid.revision && width == grid.width && height == grid.height)
+        return false;
+
+    width    = grid.width;
+    height   = grid.height;
+    revision = grid.revision;
+    const int cells = grid.cellCount();
+    invDegree.resize(cells);
+    exits.assign((cells + 3) & ~3, 0);       // whole 32-bit words: the bot kernels gather by word
+
+    for (int r = 0; r < height; ++r)
+    {
+        for (int w = 0; w < grid.stride; ++w)
+        {
+            std::uint64_t open[4];
+            for (int s = 0; s < 4; ++s)
+                open[s] = grid.exitMask(r, w, s);
+
+            const int c0   = w * 64;
+            const int cEnd = std::min(c0 + 64, width);
+            for (int c = c0; c < cEnd; ++c)
+            {
+                const int bit = c - c0;
+                const std::uint8_t e = static_cast<std::uint8_t>(
+                    ((open[0] >> bit) & 1u)        | (((open[1] >> bit) & 1u) << 1) |
+                    (((open[2] >> bit) & 1u) << 2) | (((open[3] >> bit) & 1u) << 3));
+                const int count = ((e >> 0) & 1) + ((e >> 1) & 1) + ((e >> 2) & 1) + ((e >> 3) & 1);
+                const int idx = grid.index(c, r);
+                exits[idx]     = e;
+                invDegree[idx] = count ? 1.0f / static_cast<float>(count) : 0.0f;
+            }
+        }
+    }
+    return true;
+}
+
+const EvolveStencil& evolveStencil(const Grid& grid)
+{
+    static EvolveStencil cache;
+    cache.update(grid);
+    return cache;
+}
+
+/* ------------------------------------------------------------------------- */
+/* scalar kernel                                                             */
+/* ------------------------------------------------------------------------- */
+/** New mass of cell @p i; @p in holds cells from @p inBase on. */
+static inline float gatherCell(const EvolveStencil& s, const float* in, int inBase, int i)
+{
+    const float*       inv = s.invDegree.data();
+    const std::uint8_t e   = s.exits[i];
+    const int          w   = s.width;
+    const float*       x   = in + (i - inBase);
+    float acc = 0.0f;
+    if (e & 1u) acc += x[ 1] * inv[i + 1];
+    if (e & 2u) acc += x[ w] * inv[i + w];
+    if (e & 4u) acc += x[-1] * inv[i - 1];
+    if (e & 8u) acc += x[-w] * inv[i - w];
+    return acc;
+}
+
+static void evolveSpanScalar(const EvolveStencil& s, const float* in, int inBase,
+                             float* out, int outBase, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+        out[i - outBase] = gatherCell(s, in, inBase, i);
+}
+
+void evolveKernelScalar(const EvolveStencil& stencil, const float* in, float* out)
+{
+    evolveSpanScalar(stencil, in, 0, out, 0, 0, stencil.width * stencil.height);
+}
+
+/* ------------------------------------------------------------------------- */
+/* sparse kernel                                                             */
+/* ------------------------------------------------------------------------- */
+void ActiveSet::reset(int cellCount)
+{
+    cells.clear();
+    bits.assign((static_cast<std::size_t>(cellCount) + 63) / 64, 0);
+}
+
+void ActiveSet::clear()
+{
+    for (int c : cells)
+        bits[c >> 6] &= ~(std::uint64_t{1} << (c & 63));
+    cells.clear();
+}
+
+void evolveSparse(const EvolveStencil& stencil, const float* in, float* out,
+                  const ActiveSet& active, ActiveSet& next)
+{
+    const int offset[4] = { 1, stencil.width, -1, -stencil.width };
+    for (int a : active.cells)
+    {
+        const std::uint8_t e = stencil.exits[a];
+        for (int side = 0; side < 4; ++side)
+        {
+            if (!((e >> side) & 1u)) continue;
+            const int n = a + offset[side];
+            if (next.insert(n))
+                out[n] = gatherCell(stencil, in, 0, n);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* ensemble kernels                                                          */
+/* ------------------------------------------------------------------------- */
+/** Open neighbours of cell @p i: row pointers into @p in and their weights.
+ *  Each cell's exits are decoded once and reused for every lane.
+ */
+static inline int gatherSources(const EvolveStencil& s, const float* in, int lanes, int i,
+                                const float* src[4], float coef[4])
+{
+    const int          offset[4] = { 1, s.width, -1, -s.width };
+    const std::uint8_t e = s.exits[i];
+    int open = 0;
+    for (int side = 0; side < 4; ++side)
+    {
+        if (!((e >> side) & 1u)) continue;
+        const int n = i + offset[side];
+        src[open]  = in + static_cast<std::size_t>(n) * lanes;
+        coef[open] = s.invDegree[n];
+        ++open;
+    }
+    return open;
+}
+
+void evolveEnsembleKernelScalar(const EvolveStencil& stencil, const float* in, float* out, int lanes)
+{
+    const int cells = stencil.width * stencil.height;
+    for (int i = 0; i < cells; ++i)
+    {
+        const float* src[4];
+        float        coef[4];
+        const int    open = gatherSources(stencil, in, lanes, i, src, coef);
+        float*       o    = out + static_cast<std::size_t>(i) * lanes;
+        for (int k = 0; k < lanes; ++k)
+        {
+            float acc = 0.0f;
+            for (int j = 0; j < open; ++j)
+                acc += src[j][k] * coef[j];
+            o[k] = acc;
+        }
+    }
+}
+
+#ifdef QUANTUM_KERNELS_X86
+/* ------------------------------------------------------------------------- */
+/* AVX2 kernel (8 cells per iteration)                                       */
+/* ------------------------------------------------------------------------- */
+__attribute__((target("avx2")))
+static void evolveSpanAvx2(const EvolveStencil& s, const float* in, int inBase,
+                           float* out, int outBase, int begin, int end)
+{
+    const int w      = s.width;
+    const int vBegin = std::max(begin, w);
+    const int vEnd   = std::min(end, w * s.height - w);
+    if (vBegin >= vEnd) { evolveSpanScalar(s, in, inBase, out, outBase, begin, end); return; }
+
+    const float*        inv = s.invDegree.data();
+    const std::uint8_t* ex  = s.exits.data();
+    const int           offset[4] = { 1, w, -1, -w };
+    const __m256i       bit[4] = { _mm256_set1_epi32(1), _mm256_set1_epi32(2),
+                                   _mm256_set1_epi32(4), _mm256_set1_epi32(8) };
+
+    evolveSpanScalar(s, in, inBase, out, outBase, begin, vBegin);
+    int i = vBegin;
+    for (; i + 8 <= vEnd; i += 8)
+    {
+        const __m256i e = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ex + i)));
+        __m256 acc = _mm256_setzero_ps();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __m256 open = _mm256_castsi256_ps(
+                _mm256_cmpeq_epi32(_mm256_and_si256(e, bit[side]), bit[side]));
+            const int n = i + offset[side];
+            const __m256 q = _mm256_mul_ps(_mm256_loadu_ps(in + (n - inBase)), _mm256_loadu_ps(inv + n));
+            acc = _mm256_add_ps(acc, _mm256_and_ps(open, q));
+        }
+        _mm256_storeu_ps(out + (i - outBase), acc);
+    }
+    evolveSpanScalar(s, in, inBase, out, outBase, i, end);
+}
+
+/* ------------------------------------------------------------------------- */
+/* AVX-512 kernel (16 cells per iteration)                                   */
+/* ------------------------------------------------------------------------- */
+__attribute__((target("avx512f")))
+static void evolveSpanAvx512(const EvolveStencil& s, const float* in, int inBase,
+                             float* out, int outBase, int begin, int end)
+{
+    const int w      = s.width;
+    const int vBegin = std::max(begin, w);
+    const int vEnd   = std::min(end, w * s.height - w);
+    if (vBegin >= vEnd) { evolveSpanScalar(s, in, inBase, out, outBase, begin, end); return; }
+
+    const float*        inv = s.invDegree.data();
+    const std::uint8_t* ex  = s.exits.data();
+    const int           offset[4] = { 1, w, -1, -w };
+    const __m512i       bit[4] = { _mm512_set1_epi32(1), _mm512_set1_epi32(2),
+                                   _mm512_set1_epi32(4), _mm512_set1_epi32(8) };
+
+    evolveSpanScalar(s, in, inBase, out, outBase, begin, vBegin);
+    int i = vBegin;
+    for (; i + 16 <= vEnd; i += 16)
+    {
+        const __m512i e = _mm512_cvtepu8_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(ex + i)));
+        __m512 acc = _mm512_setzero_ps();
+        for (int side = 0; side < 4; ++side)
+        {
+            const __mmask16 open = _mm512_test_epi32_mask(e, bit[side]);
+            const int n = i + offset[side];
+            const __m512 q = _mm512_mul_ps(_mm512_loadu_ps(in + (n - inBase)), _mm512_loadu_ps(inv + n));
+            acc = _mm512_mask_add_ps(acc, open, acc, q);
+        }
+        _mm512_storeu_ps(out + (i - outBase), acc);
+    }
+    evolveSpanScalar(s, in, inBase, out, outBase, i, end);
+}
+
+/* ------------------------------------------------------------------------- */
+/* SIMD ensemble kernels (lanes is a multiple of QUANTUM_ENSEMBLE_ALIGN)     */
+/* ------------------------------------------------------------------------- */
+__attribute__((target("avx2")))
+static void evolveEnsembleKernelAvx2(const EvolveStencil& s, const float* in, float* out, int lanes)
+{
+    const int cells = s.width * s.height;
+    for (int i = 0; i < cells; ++i)
+    {
+        const float* src[4];
+        float        coef[4];
+        const int    open = gatherSources(s, in, lanes, i, src, coef);
+        float*       o    = out + static_cast<std::size_t>(i) * lanes;
+        for (int k = 0; k < lanes; k += 8)
+        {
+            __m256 acc = _mm256_setzero_ps();
+            for (int j = 0; j < open; ++j)
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(src[j] + k),
+                                                       _mm256_set1_ps(coef[j])));
+            _mm256_storeu_ps(o + k, acc);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static void evolveEnsembleKernelAvx512(const EvolveStencil& s, const float* in, float* out, int lanes)
+{
+    const int cells = s.width * s.height;
+    for (int i = 0; i < cells; ++i)
+    {
+        const float* src[4];
+        float        coef[4];
+        const int    open = gatherSources(s, in, lanes, i, src, coef);
+        float*       o    = out + static_cast<std::size_t>(i) * lanes;
+        for (int k = 0; k < lanes; k += 16)
+        {
+            __m512 acc = _mm512_setzero_ps();
+            for (int j = 0; j < open; ++j)
+                acc = _mm512_add_ps(acc, _mm512_mul_ps(_mm512_loadu_ps(src[j] + k),
+                                                       _mm512_set1_ps(coef[j])));
+            _mm512_storeu_ps(o + k, acc);
+        }
+    }
+}
+#endif // QUANTUM_KERNELS_X86
+
+/* ------------------------------------------------------------------------- */
+/* dispatch                                                                  */
+/* ------------------------------------------------------------------------- */
+using EvolveSpanFn     = void (*)(const EvolveStencil&, const float*, int, float*, int, int, int);
+using EvolveEnsembleFn = void (*)(const EvolveStencil&, const float*, float*, int);
+
+struct EvolveDispatch {
+    EvolveSpanFn     span;
+    EvolveEnsembleFn ensemble;
+    const char*      name;
+};
+
+static EvolveDispatch pickEvolveKernel()
+{
+#ifdef QUANTUM_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return { evolveSpanAvx512, evolveEnsembleKernelAvx512, "avx512" };
+    if (__builtin_cpu_supports("avx2"))
+        return { evolveSpanAvx2, evolveEnsembleKernelAvx2, "avx2" };
+#endif
+    return { evolveSpanScalar, evolveEnsembleKernelScalar, "scalar" };
+}
+
+static const EvolveDispatch& evolveDispatch()
+{
+    static const EvolveDispatch chosen = pickEvolveKernel();
+    return chosen;
+}
+
+void evolveKernel(const EvolveStencil& stencil, const float* in, float* out)
+{
+    evolveDispatch().span(stencil, in, 0, out, 0, 0, stencil.width * stencil.height);
+}
+
+void evolveKernelParallel(const EvolveStencil& stencil, const float* in, float* out,
+                          ThreadPool& pool)
+{
+    const EvolveSpanFn span  = evolveDispatch().span;
+    const int          w     = stencil.width;
+    const int          bands = pool.size();
+    pool.run(bands, [&](int band) {
+        int r0, r1;
+        bandRows(band, bands, stencil.height, r0, r1);
+        span(stencil, in, 0, out, 0, r0 * w, r1 * w);
+    });
+}
+
+void evolveEnsembleKernel(const EvolveStencil& stencil, const float* in, float* out, int lanes)
+{
+    evolveDispatch().ensemble(stencil, in, out, lanes);
+}
+
+/* ------------------------------------------------------------------------- */
+/* temporal blocking                                                         */
+/* ------------------------------------------------------------------------- */
+/** Runs @p steps steps as rounds of up to QUANTUM_BLOCK_STEPS.  In a round
+ *  each band of rows is advanced all the way inside two small band buffers:
+ *  step 1 reads the round's source field, intermediate steps stay in the
+ *  (cache-resident) bands, and the last step writes the band's own rows to
+ *  the destination field.  Every intermediate step also recomputes a halo
+ *  that shrinks by one row per step, which is the price of never touching
+ *  main memory between the first read and the last write.
+ */
+void evolveKernelSteps(const EvolveStencil& stencil, std::vector<float>& field,
+                       std::vector<float>& spare, int steps, ThreadPool* pool)
+{
+    const int w     = stencil.width;
+    const int h     = stencil.height;
+    const int cells = w * h;
+    const EvolveSpanFn span = evolveDispatch().span;
+    spare.resize(field.size());
+    const bool parallel = pool && pool->size() > 1 && cells >= QUANTUM_PARALLEL_MIN_CELLS;
+
+    const bool fitsInCache = static_cast<std::size_t>(cells) * 2 * sizeof(float) <= QUANTUM_BAND_BYTES;
+    if (fitsInCache || steps < 2)
+    {
+        for (int k = 0; k < steps; ++k)
+        {
+            if (parallel) evolveKernelParallel(stencil, field.data(), spare.data(), *pool);
+            else          span(stencil, field.data(), 0, spare.data(), 0, 0, cells);
+            field.swap(spare);
+        }
+        return;
+    }
+
+    while (steps > 0)
+    {
+        const int T    = std::min(steps, QUANTUM_BLOCK_STEPS);
+        const int rows = std::max(T, static_cast<int>(QUANTUM_BAND_BYTES / (2 * sizeof(float) * w)) - 2 * T);
+
+        auto band = [&](int r0, int r1) {
+            static thread_local std::vector<float> bandA, bandB;
+            bandA.resize(static_cast<std::size_t>(rows + 2 * T) * w);
+            bandB.resize(bandA.size());
+
+            const int lo = std::max(0, r0 - (T - 1));      // rows held in the bands
+            const float* src     = field.data();
+            int          srcBase = 0;
+            float*       dst     = bandA.data();
+            for (int t = 1; t <= T; ++t)
+            {
+                const int a = std::max(0, r0 - (T - t));   // rows still exact after step t
+                const int b = std::min(h, r1 + (T - t));
+                if (t == T)
+                {
+                    span(stencil, src, srcBase, spare.data(), 0, a * w, b * w);
+                    break;
+                }
+                span(stencil, src, srcBase, dst, lo * w, a * w, b * w);
+                src     = dst;
+                srcBase = lo * w;
+                dst     = (dst == bandA.data()) ? bandB.data() : bandA.data();
+            }
+        };
+
+        // worker k walks the cache-sized bands inside its own share of rows,
+        // the rows firstTouchFill placed on its node
+        auto share = [&](int first, int last) {
+            for (int r0 = first; r0 < last; r0 += rows)
+                band(r0, std::min(last, r0 + rows));
+        };
+        if (parallel)
+            pool->run(pool->size(), [&](int k) {
+                int first, last;
+                bandRows(k, pool->size(), h, first, last);
+                share(first, last);
+            });
+        else
+            share(0, h);
+
+        field.swap(spare);
+        steps -= T;
+    }
+}
+
+const char* evolveKernelName()
+{
+    return evolveDispatch().name;
+}
@@ -0,0 +1,375 @@
+// =============================================================================
+// quantumWalk.cpp — Coined discrete-time quantum walk (complex amplitudes)
+//
+// Coin: every cell applies the 4×4 complex matrix C[mask] picked by its
+// open-exit mask.  The 16 possible matrices are stored entry-major,
+// table[j][l][mask], so a SIMD lane fetches its coefficient with one
+// in-register table lookup (permutexvar on AVX-512, two permutevar8x32 and
+// a blend on AVX2).
+//
+// Step: shift and coin fused into one out-of-place sweep.  The state is
+// kept after the coin, so each cell gathers the amplitudes arriving from
+// its neighbours (shift) and mixes them with its own coin right away; the
+// 8 amplitude planes are streamed once per step instead of three times.
+// =============================================================================
+
+#include "../include/quantumWalk.hpp"
+#include "../include/quantumKernels.hpp"  // evolveStencil (exit masks)
+#include <algorithm>                      // std::clamp, std::max, std::min
+#include <cmath>                          // std::cos, std::sin, std::sqrt
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QUANTUM_WALK_X86 1
+#include <immintrin.h>                    // AVX2 / AVX-512 intrinsics
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* coin tables                                                               */
+/* ------------------------------------------------------------------------- */
+struct CoinTable {
+    float re[4][4][16];   // re[j][l][mask] = Re C_mask[j][l]
+    float im[4][4][16];
+    bool  real;           // all imaginary parts zero (skip half the work)
+};
+
+static CoinTable buildCoinTable(QuantumCoin coin)
+{
+    CoinTable t{};
+    t.real = (coin == QuantumCoin::Grover);
+    for (int mask = 0; mask < 16; ++mask)
+    {
+        int open[4];
+        int k = 0;
+        for (int d = 0; d < 4; ++d)
+            if ((mask >> d) & 1) open[k++] = d;
+            else                 t.re[d][d][mask] = 1.0f;     // closed: identity
+
+        const double pi = 3.14159265358979323846;
+        for (int a = 0; a < k; ++a)
+            for (int b = 0; b < k; ++b)
+            {
+                double cr, ci;
+                if (coin == QuantumCoin::Grover)
+                {
+                    cr = 2.0 / k - (a == b ? 1.0 : 0.0);
+                    ci = 0.0;
+                }
+                else
+                {
+                    const double phase = 2.0 * pi * a * b / k;
+                    cr = std::cos(phase) / std::sqrt(static_cast<double>(k));
+                    ci = std::sin(phase) / std::sqrt(static_cast<double>(k));
+                }
+                t.re[open[a]][open[b]][mask] = static_cast<float>(cr);
+                t.im[open[a]][open[b]][mask] = static_cast<float>(ci);
+            }
+    }
+    return t;
+}
+
+static const CoinTable& coinTable(QuantumCoin coin)
+{
+    static const CoinTable grover  = buildCoinTable(QuantumCoin::Grover);
+    static const CoinTable fourier = buildCoinTable(QuantumCoin::Fourier);
+    return coin == QuantumCoin::Grover ? grover : fourier;
+}
+
+bool parseQuantumCoin(const std::string& name, QuantumCoin& out)
+{
+    if (name == "grover")                         { out = QuantumCoin::Grover;  return true; }
+    if (name == "fourier" || name == "hadamard")  { out = QuantumCoin::Fourier; return true; }
+    return false;
+}
+
+/* ------------------------------------------------------------------------- */
+/* scalar kernels                                                            */
+/* ------------------------------------------------------------------------- */
+struct Planes {
+    const float* re[4];
+    const float* im[4];
+};
+
+struct OutPlanes {
+    float* re[4];
+    float* im[4];
+};
+
+/** One fused step for cells [begin,end): gather the arriving amplitudes
+ *  (shift), then mix them with the cell's coin.
+ */
+static void stepRange(const CoinTable& t, const std::uint8_t* ex, int w,
+                      Planes in, OutPlanes out, int begin, int end)
+{
+    const int offset[4] = { 1, w, -1, -w };
+    for (int c = begin; c < end; ++c)
+    {
+        const int m = ex[c];
+        float r[4], i[4];
+        for (int d = 0; d < 4; ++d)
+        {
+            const bool open = (m >> d) & 1u;
+            const int  src  = open ? c + offset[d] : c;
+            const int  dir  = open ? (d + 2) & 3   : d;     // arrive from the opposite side
+            r[d] = in.re[dir][src];
+            i[d] = in.im[dir][src];
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+            float sr = 0.0f, si = 0.0f;
+            for (int l = 0; l < 4; ++l)
+            {
+                const float a = t.re[j][l][m], b = t.im[j][l][m];
+                sr += a * r[l] - b * i[l];
+                si += a * i[l] + b * r[l];
+            }
+            out.re[j][c] = sr;
+            out.im[j][c] = si;
+        }
+    }
+}
+
+static void stepScalar(const CoinTable& t, const std::uint8_t* ex, int w, int cells,
+                       Planes in, OutPlanes out)
+{
+    stepRange(t, ex, w, in, out, 0, cells);
+}
+
+#ifdef QUANTUM_WALK_X86
+/* ------------------------------------------------------------------------- */
+/* AVX2 kernel (8 cells per iteration)                                       */
+/* ------------------------------------------------------------------------- */
+__attribute__((target("avx2,fma")))
+static inline __m256 lookup8(const float* table16, __m256i idx, __m256 hiSel)
+{
+    const __m256 lo = _mm256_permutevar8x32_ps(_mm256_loadu_ps(table16),     idx);
+    const __m256 hi = _mm256_permutevar8x32_ps(_mm256_loadu_ps(table16 + 8), idx);
+    return _mm256_blendv_ps(lo, hi, hiSel);
+}
+
+/** Vector lanes cover [w, cells - w), where every neighbour load stays
+ *  inside the planes; the first and last rows run the scalar path.
+ */
+__attribute__((target("avx2,fma")))
+static void stepAvx2(const CoinTable& t, const std::uint8_t* ex, int w, int cells,
+                     Planes in, OutPlanes out)
+{
+    const int vBegin = w, vEnd = cells - w;
+    if (vBegin >= vEnd) { stepRange(t, ex, w, in, out, 0, cells); return; }
+
+    const int offset[4] = { 1, w, -1, -w };
+    stepRange(t, ex, w, in, out, 0, vBegin);
+    int c = vBegin;
+    for (; c + 8 <= vEnd; c += 8)
+    {
+        const __m256i idx   = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ex + c)));
+        const __m256  hiSel = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 28));   // bit 3 → sign
+        __m256 r[4], i[4];
+        for (int d = 0; d < 4; ++d)
+        {
+            const int     opp  = (d + 2) & 3;
+            const __m256i bit  = _mm256_set1_epi32(1 << d);
+            const __m256  open = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(idx, bit), bit));
+            const int     n    = c + offset[d];
+            r[d] = _mm256_blendv_ps(_mm256_loadu_ps(in.re[d] + c), _mm256_loadu_ps(in.re[opp] + n), open);
+            i[d] = _mm256_blendv_ps(_mm256_loadu_ps(in.im[d] + c), _mm256_loadu_ps(in.im[opp] + n), open);
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+            __m256 sr = _mm256_setzero_ps(), si = _mm256_setzero_ps();
+            for (int l = 0; l < 4; ++l)
+            {
+                const __m256 a = lookup8(t.re[j][l], idx, hiSel);
+                sr = _mm256_fmadd_ps(a, r[l], sr);
+                si = _mm256_fmadd_ps(a, i[l], si);
+                if (!t.real)
+                {
+                    const __m256 b = lookup8(t.im[j][l], idx, hiSel);
+                    sr = _mm256_fnmadd_ps(b, i[l], sr);
+                    si = _mm256_fmadd_ps(b, r[l], si);
+                }
+            }
+            _mm256_storeu_ps(out.re[j] + c, sr);
+            _mm256_storeu_ps(out.im[j] + c, si);
+        }
+    }
+    stepRange(t, ex, w, in, out, c, cells);
+}
+
+/* ------------------------------------------------------------------------- */
+/* AVX-512 kernel (16 cells per iteration)                                   */
+/* ------------------------------------------------------------------------- */
+__attribute__((target("avx512f")))
+static void stepAvx512(const CoinTable& t, const std::uint8_t* ex, int w, int cells,
+                       Planes in, OutPlanes out)
+{
+    const int vBegin = w, vEnd = cells - w;
+    if (vBegin >= vEnd) { stepRange(t, ex, w, in, out, 0, cells); return; }
+
+    const int offset[4] = { 1, w, -1, -w };
+    stepRange(t, ex, w, in, out, 0, vBegin);
+    int c = vBegin;
+    for (; c + 16 <= vEnd; c += 16)
+    {
+        const __m512i idx = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ex + c)));
+        __m512 r[4], i[4];
+        for (int d = 0; d < 4; ++d)
+        {
+            const int       opp  = (d + 2) & 3;
+            const __mmask16 open = _mm512_test_epi32_mask(idx, _mm512_set1_epi32(1 << d));
+            const int       n    = c + offset[d];
+            r[d] = _mm512_mask_blend_ps(open, _mm512_loadu_ps(in.re[d] + c), _mm512_loadu_ps(in.re[opp] + n));
+            i[d] = _mm512_mask_blend_ps(open, _mm512_loadu_ps(in.im[d] + c), _mm512_loadu_ps(in.im[opp] + n));
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+            __m512 sr = _mm512_setzero_ps(), si = _mm512_setzero_ps();
+            for (int l = 0; l < 4; ++l)
+            {
+                const __m512 a = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(t.re[j][l]));
+                sr = _mm512_fmadd_ps(a, r[l], sr);
+                si = _mm512_fmadd_ps(a, i[l], si);
+                if (!t.real)
+                {
+                    const __m512 b = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(t.im[j][l]));
+                    sr = _mm512_fnmadd_ps(b, i[l], sr);
+                    si = _mm512_fmadd_ps(b, r[l], si);
+                }
+            }
+            _mm512_storeu_ps(out.re[j] + c, sr);
+            _mm512_storeu_ps(out.im[j] + c, si);
+        }
+    }
+    stepRange(t, ex, w, in, out, c, cells);
+}
+#endif // QUANTUM_WALK_X86
+
+/* ------------------------------------------------------------------------- */
+/* dispatch                                                                  */
+/* ------------------------------------------------------------------------- */
+struct WalkDispatch {
+    void (*step)(const CoinTable&, const std::uint8_t*, int, int, Planes, OutPlanes);
+    const char* name;
+};
+
+static const WalkDispatch& walkDispatch()
+{
+    static const WalkDispatch chosen = []() -> WalkDispatch {
+#ifdef QUANTUM_WALK_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return { stepAvx512, "avx512" };
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return { stepAvx2, "avx2" };
+#endif
+        return { stepScalar, "scalar" };
+    }();
+    return chosen;
+}
+
+const char* QuantumWalk::kernelName()
+{
+    return walkDispatch().name;
+}
+
+static OutPlanes planesOf(std::vector<float>& v, int cells)
+{
+    OutPlanes p;
+    for (int d = 0; d < 4; ++d)
+    {
+        p.re[d] = &v[static_cast<std::size_t>(2 * d) * cells];
+        p.im[d] = &v[static_cast<std::size_t>(2 * d + 1) * cells];
+    }
+    return p;
+}
+
+static Planes constPlanes(const OutPlanes& p)
+{
+    Planes c;
+    for (int d = 0; d < 4; ++d) { c.re[d] = p.re[d]; c.im[d] = p.im[d]; }
+    return c;
+}
+
+/* ------------------------------------------------------------------------- */
+/* QuantumWalk                                                               */
+/* ------------------------------------------------------------------------- */
+void QuantumWalk::initializeAt(const Grid& grid, int col, int row)
+{
+    width  = grid.width;
+    height = grid.height;
+    state.assign(static_cast<std::size_t>(8) * cells(), 0.0f);
+    spare.assign(state.size(), 0.0f);
+
+    const int c = grid.index(std::clamp(col, 0, width - 1), std::clamp(row, 0, height - 1));
+    int open = 0;
+    for (int d = 0; d < 4; ++d) open += !grid.hasWall(c % width, c / width, d);
+    if (open == 0)
+    {
+        re(SIDE_RIGHT)[c] = 1.0f;            // sealed cell: the walker just sits there
+        return;
+    }
+    const float amp = 1.0f / std::sqrt(static_cast<float>(open));
+    for (int d = 0; d < 4; ++d)
+        if (!grid.hasWall(c % width, c / width, d)) spare[static_cast<std::size_t>(2 * d) * cells() + c] = amp;
+
+    // the state holds post-coin amplitudes: coin the start cell in place
+    // (a closed side has no neighbour to arrive from, so stepRange reads c)
+    const CoinTable& t = coinTable(coin);
+    const int m = evolveStencil(grid).exits[c];
+    for (int j = 0; j < 4; ++j)
+        for (int l = 0; l < 4; ++l)
+        {
+            const float a  = spare[static_cast<std::size_t>(2 * l) * cells() + c];
+            re(j)[c] += t.re[j][l][m] * a;
+            im(j)[c] += t.im[j][l][m] * a;
+        }
+    for (int d = 0; d < 4; ++d) spare[static_cast<std::size_t>(2 * d) * cells() + c] = 0.0f;
+}
+
+void QuantumWalk::step(const Grid& grid)
+{
+    if (width != grid.width || height != grid.height)
+        initializeAt(grid, grid.width / 2, grid.height / 2);   // grid was resized under us
+
+    walkDispatch().step(coinTable(coin), evolveStencil(grid).exits.data(), width, cells(),
+                        constPlanes(planesOf(state, cells())), planesOf(spare, cells()));
+    state.swap(spare);
+}
+
+void QuantumWalk::probability(std::vector<float>& out) const
+{
+    const int n = cells();
+    out.assign(n, 0.0f);
+    for (int d = 0; d < 4; ++d)
+    {
+        const float* r = re(d);
+        const float* i = im(d);
+        for (int c = 0; c < n; ++c) out[c] += r[c] * r[c] + i[c] * i[c];
+    }
+}
+
+void QuantumWalk::scroll(int rows, const Grid& grid)
+{
+    const int n = cells();
+    const int shift = rows * width;
+    if (width != grid.width || height != grid.height || shift >= n)
+    {
+        initializeAt(grid, grid.width / 2, grid.height / 2);
+        return;
+    }
+
+    double norm = 0.0;
+    for (int plane = 0; plane < 8; ++plane)
+    {
+        float* p = &state[static_cast<std::size_t>(plane) * n];
+        std::copy(p + shift, p + n, p);
+        std::fill(p + n - shift, p + n, 0.0f);
+        for (int c = 0; c < n - shift; ++c) norm += static_cast<double>(p[c]) * p[c];
+    }
+    if (norm <= 0.0)
+    {
+        initializeAt(grid, grid.width / 2, grid.height / 2);   // everything scrolled away
+        return;
+    }
+    const float scale = static_cast<float>(1.0 / std::sqrt(norm));
+    for (float& a : state) a *= scale;
+}
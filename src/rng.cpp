@@ -0,0 +1,46 @@
+// =============================================================================
+// rng.cpp — Run-wide seeding for the PCG32 streams declared in rng.hpp
+//
+// One master seed (command line --seed, or the clock) feeds every random
+// stream of the run.  Subsystems and entities derive their own stream with
+// makeRng(subsystem, index); threads get a thread_local generator.
+// =============================================================================
+
+#include "../include/rng.hpp"
+#include <atomic>              // thread numbering
+
+static std::uint64_t              g_masterSeed  = 0x5EEDull;
+static std::atomic<std::uint64_t> g_threadCount{0};
+
+static Rng& threadRngSlot()
+{
+    thread_local Rng rng;
+    thread_local bool seeded = false;
+    if (!seeded)
+    {
+        rng.seed(mix64(g_masterSeed ^ mix64(RNG_STREAM_THREAD)), g_threadCount.fetch_add(1));
+        seeded = true;
+    }
+    return rng;
+}
+
+void setMasterSeed(std::uint64_t seed)
+{
+    g_masterSeed = seed;
+    threadRngSlot().seed(mix64(g_masterSeed ^ mix64(RNG_STREAM_THREAD)), 0);
+}
+
+std::uint64_t masterSeed()
+{
+    return g_masterSeed;
+}
+
+Rng makeRng(std::uint64_t subsystem, std::uint64_t index)
+{
+    return Rng(mix64(g_masterSeed ^ mix64(subsystem)), index);
+}
+
+Rng& threadRng()
+{
+    return threadRngSlot();
+}
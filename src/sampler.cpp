@@ -0,0 +1,247 @@
+// =============================================================================
+// sampler.cpp — Measurement sampling from probability fields
+// =============================================================================
+
+#include "../include/sampler.hpp"
+#include "../include/rng.hpp"     // counterRandom
+#include <algorithm>              // std::upper_bound, std::sort
+
+#if defined(__GNUC__)
+#define SAMPLER_NOINLINE __attribute__((noinline))
+#else
+#define SAMPLER_NOINLINE
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* prefix sums                                                               */
+/* ------------------------------------------------------------------------- */
+bool FieldSampler::build(const float* field, int n)
+{
+    prefix.resize(n);
+    aliasProb.clear();
+    alias.clear();
+    blockPrefix.clear();
+    cells = n;
+    double sum = 0.0;
+    last = -1;
+    for (int i = 0; i < n; ++i)
+    {
+        const float p = field[i] > 0.0f ? field[i] : 0.0f;   // ignore rounding negatives
+        sum += p;
+        prefix[i] = sum;
+        last = p > 0.0f ? i : last;
+    }
+    total = sum;
+    return last >= 0;
+}
+
+int FieldSampler::sample(double u) const
+{
+    if (last < 0) return -1;
+    const double target = u * total;
+    const int cell = static_cast<int>(std::upper_bound(prefix.begin(), prefix.begin() + last, target)
+                                      - prefix.begin());
+    return cell;                             // past every prefix: the last cell with mass
+}
+
+/* ------------------------------------------------------------------------- */
+/* block prefix sums                                                         */
+/* ------------------------------------------------------------------------- */
+/** Adds @p n cells to the running sum @p sum, the way build() does.  Kept
+ *  out of line so the sum lives in a register for the loop instead of the
+ *  stack slot that carries it across the reader calls. */
+SAMPLER_NOINLINE
+static double addBlock(const float* in, int n, double sum, bool& mass)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        const float p = in[i] > 0.0f ? in[i] : 0.0f;         // ignore rounding negatives
+        sum  += p;
+        mass |= p > 0.0f;
+    }
+    return sum;
+}
+
+/** Same running double sum as build(), kept only at block ends, so a draw
+ *  can rebuild the exact per-cell sums of the one block it lands in. */
+bool FieldSampler::buildBlocks(int n, const FieldReader& read)
+{
+    std::vector<double>().swap(prefix);
+    std::vector<float>().swap(aliasProb);
+    std::vector<int>().swap(alias);
+    cells = n;
+    blockPrefix.resize((n + SAMPLER_BLOCK_CELLS - 1) / SAMPLER_BLOCK_CELLS);
+
+    std::vector<float> buf(SAMPLER_BLOCK_CELLS);
+    double sum = 0.0;
+    int    lastBlock = -1;                   // last block holding mass
+    for (int b = 0, begin = 0; begin < n; ++b, begin += SAMPLER_BLOCK_CELLS)
+    {
+        const int end = std::min(n, begin + SAMPLER_BLOCK_CELLS);
+        read(begin, end, buf.data());
+        bool mass = false;
+        sum = blockPrefix[b] = addBlock(buf.data(), end - begin, sum, mass);
+        lastBlock = mass ? b : lastBlock;
+    }
+    total = sum;
+
+    last = -1;
+    if (lastBlock >= 0)
+    {
+        const int begin = lastBlock * SAMPLER_BLOCK_CELLS;
+        const int end   = std::min(n, begin + SAMPLER_BLOCK_CELLS);
+        read(begin, end, buf.data());
+        for (int i = end - begin - 1; i >= 0 && last < 0; --i)
+            last = buf[i] > 0.0f ? begin + i : -1;
+    }
+    return last >= 0;
+}
+
+void FieldSampler::blockSums(int b, const FieldReader& read, std::vector<float>& buf,
+                             std::vector<double>& sums) const
+{
+    const int begin = b * SAMPLER_BLOCK_CELLS;
+    const int end   = std::min(cells, begin + SAMPLER_BLOCK_CELLS);
+    buf.resize(SAMPLER_BLOCK_CELLS);
+    read(begin, end, buf.data());
+
+    // cells from `last` on are never searched, as in sample()
+    const int limit = std::min(end, last) - begin;
+    sums.resize(std::max(0, limit));
+    double sum = b > 0 ? blockPrefix[b - 1] : 0.0;
+    for (int i = 0; i < limit; ++i)
+    {
+        sum += buf[i] > 0.0f ? buf[i] : 0.0f;
+        sums[i] = sum;
+    }
+}
+
+int FieldSampler::pickInBlock(int b, const std::vector<double>& sums, double target) const
+{
+    const int i = static_cast<int>(std::upper_bound(sums.begin(), sums.end(), target) - sums.begin());
+    return i < static_cast<int>(sums.size()) ? b * SAMPLER_BLOCK_CELLS + i : last;
+}
+
+int FieldSampler::sample(double u, const FieldReader& read) const
+{
+    if (last < 0) return -1;
+    const double target    = u * total;
+    const int    lastBlock = last / SAMPLER_BLOCK_CELLS;
+    const int    b = static_cast<int>(std::upper_bound(blockPrefix.begin(), blockPrefix.begin() + lastBlock, target)
+                                      - blockPrefix.begin());
+    std::vector<float>  buf;
+    std::vector<double> sums;
+    blockSums(b, read, buf, sums);
+    return pickInBlock(b, sums, target);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Vose alias table                                                          */
+/* ------------------------------------------------------------------------- */
+/** Scales the field to mean 1, then repeatedly tops up an under-full slot
+ *  (small) from an over-full one (large), which becomes its alias.  Every
+ *  slot ends up with its own cell plus at most one alias.
+ */
+bool FieldSampler::buildAlias(const float* field, int n)
+{
+    if (!build(field, n)) return false;
+
+    aliasProb.assign(n, 1.0f);
+    alias.resize(n);
+    std::vector<double> scaled(n);
+    std::vector<int>    small, large;
+    small.reserve(n);
+    large.reserve(n);
+    const double scale = n / total;
+    for (int i = 0; i < n; ++i)
+    {
+        scaled[i] = (field[i] > 0.0f ? field[i] : 0.0f) * scale;
+        alias[i]  = i;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        const int s = small.back(); small.pop_back();
+        const int l = large.back();
+        aliasProb[s] = static_cast<float>(scaled[s]);
+        alias[s]     = l;
+        scaled[l]   -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // leftovers are 1 up to rounding; a small leftover with no large partner
+    // must not keep itself if it has no mass
+    for (int s : small)
+        if (scaled[s] <= 0.0) { aliasProb[s] = 0.0f; alias[s] = last; }
+    return true;
+}
+
+int FieldSampler::sampleAlias(std::uint64_t bits) const
+{
+    if (last < 0) return -1;
+    const std::uint32_t n    = static_cast<std::uint32_t>(alias.size());
+    const std::uint32_t slot = static_cast<std::uint32_t>(((bits >> 32) * n) >> 32);
+    const float         coin = static_cast<float>(bits & 0xFFFFFFu) * (1.0f / 16777216.0f);
+    return coin < aliasProb[slot] ? static_cast<int>(slot) : alias[slot];
+}
+
+/* ------------------------------------------------------------------------- */
+/* batch                                                                     */
+/* ------------------------------------------------------------------------- */
+void FieldSampler::sampleBatch(std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                               int count, int* out) const
+{
+    if (!alias.empty())
+    {
+        for (int k = 0; k < count; ++k)
+            out[k] = sampleAlias(counterRandom(seed, stream, first + k));
+        return;
+    }
+    for (int k = 0; k < count; ++k)
+    {
+        const std::uint64_t bits = counterRandom(seed, stream, first + k);
+        out[k] = sample(static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0));   // 53-bit u
+    }
+}
+
+/** Targets are sorted by block so a block shared by many draws is decoded
+ *  once; each draw still uses its own counter, so the output matches
+ *  sample(u, read) draw by draw. */
+void FieldSampler::sampleBatch(std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                               int count, int* out, const FieldReader& read) const
+{
+    if (last < 0)
+    {
+        std::fill(out, out + count, -1);
+        return;
+    }
+    const int lastBlock = last / SAMPLER_BLOCK_CELLS;
+    std::vector<double> target(count);
+    std::vector<int>    block(count), order(count);
+    for (int k = 0; k < count; ++k)
+    {
+        const std::uint64_t bits = counterRandom(seed, stream, first + k);
+        target[k] = static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0) * total;   // 53-bit u
+        block[k]  = static_cast<int>(std::upper_bound(blockPrefix.begin(), blockPrefix.begin() + lastBlock,
+                                                      target[k]) - blockPrefix.begin());
+        order[k]  = k;
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return block[a] < block[b]; });
+
+    std::vector<float>  buf;
+    std::vector<double> sums;
+    int decoded = -1;
+    for (int k : order)
+    {
+        if (block[k] != decoded)
+        {
+            decoded = block[k];
+            blockSums(decoded, read, buf, sums);
+        }
+        out[k] = pickInBlock(decoded, sums, target[k]);
+    }
+}
@@ -0,0 +1,143 @@
+// =============================================================================
+// simulation.cpp — Fixed-timestep world update, decoupled from rendering
+// =============================================================================
+
+#include "../include/simulation.hpp"
+#include "../include/rng.hpp"     // threadRng (finish re-roll)
+#include <algorithm>              // std::min, std::max
+
+Simulation::Simulation(Grid& g, PlayerParticle& p, BotSystem& b, QuantumParticle& q,
+                       QuantumEnsemble& e, DistanceField& f, MazeStream* s)
+    : grid(g), player(p), bots(b), quantum(q), qbots(e), finishField(f), stream(s)
+{
+    snapshot();
+}
+
+/* ------------------------------------------------------------------------- */
+/* step                                                                      */
+/* ------------------------------------------------------------------------- */
+unsigned Simulation::step(const SimulationInput& input)
+{
+    const float dt = tickSeconds();
+
+    // player and bots: integrate & collide
+    player.velocity = input.move * PLAYER_SPEED;
+    player.update(dt, grid);
+    // the one update per tick: rebuilds after a scroll invalidated the field
+    finishField.update(grid, FINISH_COL, FINISH_ROW); // no-op while cached
+    if (navigate)
+        bots.steer(finishField, BOT_NAV_SPEED);       // O(1) per bot
+    bots.update(dt, grid);                   // col/row included
+
+    // endless mode: scroll the view and everything living in it
+    if (stream && (scrollTimer += dt) >= STREAM_SCROLL_SECONDS) {
+        scrollTimer -= STREAM_SCROLL_SECONDS;
+        quantum.settle(grid);                // queued steps belong to the old rows
+        qbots.settle(grid);
+        stream->scroll(grid);
+        player.scroll(1);
+        bots.scroll(1);
+        quantum.scroll(1, grid);
+        qbots.scroll(1, grid);
+        if (--FINISH_ROW < 0) {              // finish left the view, re-roll at the bottom
+            FINISH_ROW = grid.height - 1;
+            FINISH_COL = threadRng().below(grid.width);
+        }
+        finishField.invalidate();            // the walls moved under it
+
+        // keep the interpolation start in the same frame of reference
+        playerPrev.y -= NODE_SIZE;
+        for (float& y : botPrevY) y -= NODE_SIZE;
+    }
+    botIndex.rebuild(bots, grid.width, grid.height);  // O(bots) counting sort
+
+    player.col = static_cast<int>(player.position.x / NODE_SIZE);
+    player.row = static_cast<int>(player.position.y / NODE_SIZE);
+    player.setPosition(player.col, player.row, grid);
+
+    unsigned events = 0;
+    if (player.col == FINISH_COL && player.row == FINISH_ROW)
+        events |= SIM_PLAYER_FINISHED;
+    if (botIndex.any(FINISH_COL, FINISH_ROW))
+        events |= SIM_OPPONENT_FINISHED;
+
+    if (input.autoCollapse)
+    {
+        quantum.advance();                   // quantum walk, run at the next measure()
+        qbots.advance();                     // every bot in one pass, also deferred
+        measurePending = true;
+    }
+
+    ++ticks;
+    return events;
+}
+
+/* ------------------------------------------------------------------------- */
+/* measure                                                                   */
+/* ------------------------------------------------------------------------- */
+/** Settling here runs the steps queued since the last measurement: one per
+ *  tick from advance(), or a single QuantumParticle::fastForward(k) and
+ *  one run of k ensemble steps for a caller that measures every k ticks. */
+unsigned Simulation::measure()
+{
+    if (!measurePending) return 0;
+    measurePending = false;
+
+    quantum.collapsed = false;               // “un‑collapse” so it can walk
+    quantum.collapse(grid);                  // runs the queued steps, then measures
+    qbots.collapseAll(grid);
+
+    return (quantum.col == FINISH_COL && quantum.row == FINISH_ROW) ? SIM_OPPONENT_FINISHED : 0u;
+}
+
+/* ------------------------------------------------------------------------- */
+/* advance                                                                   */
+/* ------------------------------------------------------------------------- */
+unsigned Simulation::advance(double frameSeconds, const SimulationInput& input)
+{
+    const double tick = 1.0 / tickRate;
+    accumulator += std::max(0.0, frameSeconds);
+
+    int due = static_cast<int>(accumulator / tick);
+    if (due > maxCatchUp)
+    {
+        accumulator -= (due - maxCatchUp) * tick;   // drop the backlog
+        due = maxCatchUp;
+    }
+
+    unsigned events = 0;
+    for (int t = 0; t < due && !events; ++t)
+    {
+        if (t == due - 1)
+            snapshot();                      // draw between the last two ticks
+        events  = step(input);
+        events |= measure();                 // on the tick schedule, like --headless
+        accumulator -= tick;
+    }
+    return events;
+}
+
+float Simulation::alpha() const
+{
+    return static_cast<float>(std::min(1.0, std::max(0.0, accumulator * tickRate)));
+}
+
+/* ------------------------------------------------------------------------- */
+/* interpolation                                                             */
+/* ------------------------------------------------------------------------- */
+void Simulation::snapshot()
+{
+    playerPrev = player.position;
+    botPrevX.assign(bots.x.begin(), bots.x.end());
+    botPrevY.assign(bots.y.begin(), bots.y.end());
+}
+
+sf::Vector2f Simulation::playerDrawPosition() const
+{
+    return playerPrev + (player.position - playerPrev) * alpha();
+}
+
+void Simulation::drawBots(sf::RenderWindow& window) const
+{
+    bots.draw(window, botPrevX, botPrevY, alpha());
+}
@@ -0,0 +1,109 @@
+// =============================================================================
+// threadPool.cpp — Persistent workers for data-parallel loops
+// =============================================================================
+
+#include "../include/threadPool.hpp"
+#include <algorithm>           // std::fill, std::max
+#include <cstdint>             // std::uintptr_t
+#include <sys/mman.h>          // madvise
+#include <unistd.h>            // sysconf
+
+/* ------------------------------------------------------------------------- */
+/* ThreadPool                                                                */
+/* ------------------------------------------------------------------------- */
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+void ThreadPool::runShare(int index)
+{
+    for (int t = index; t < jobTasks; t += size())
+        (*job)(t);
+}
+
+void ThreadPool::run(int tasks, const std::function<void(int)>& task)
+{
+    if (workers.empty() || tasks <= 1)
+    {
+        for (int t = 0; t < tasks; ++t) task(t);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job      = &task;
+        jobTasks = tasks;
+        busy     = static_cast<int>(workers.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    runShare(0);                               // the caller is worker 0
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop(int index)
+{
+    std::uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runShare(index);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) finished.notify_one();
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* first touch                                                               */
+/* ------------------------------------------------------------------------- */
+void firstTouchFill(float* data, std::size_t count, int width, float value, ThreadPool& pool)
+{
+    if (!pool.firstTouch || width <= 0)
+    {
+        std::fill(data, data + count, value);
+        return;
+    }
+
+    // drop the whole pages inside the buffer: they come back zero-filled
+    // on the next touch, allocated on the touching thread's node
+    const std::uintptr_t page  = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(data) + page - 1) & ~(page - 1);
+    const std::uintptr_t end   = reinterpret_cast<std::uintptr_t>(data + count) & ~(page - 1);
+    if (end > begin)
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+
+    const int height = static_cast<int>(count / width);
+    const int bands  = pool.size();
+    pool.run(bands, [&](int band) {
+        int r0, r1;
+        bandRows(band, bands, height, r0, r1);
+        std::fill(data + static_cast<std::size_t>(r0) * width,
+                  data + static_cast<std::size_t>(r1) * width, value);
+    });
+    std::fill(data + static_cast<std::size_t>(height) * width, data + count, value);
+}